@@ -401,6 +401,7 @@ int main()
 // O------------------------------------------------------------------------------O
 #include <cmath>
 #include <cstdint>
+#include <cstdio>
 #include <string>
 #include <iostream>
 #include <streambuf>
@@ -410,10 +411,13 @@ int main()
 #include <list>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <fstream>
 #include <map>
 #include <functional>
 #include <algorithm>
+#include <numeric>
 #include <array>
 #include <cstring>
 #pragma endregion
@@ -460,13 +464,32 @@ int main()
 
 #define UNUSED(x) (void)(x)
 
+// Vectorised pixel blending - picked up from the compiler's target flags,
+// define OLC_PGE_NO_SIMD to force the scalar paths
+#if !defined(OLC_PGE_NO_SIMD)
+	#if defined(__AVX2__)
+		#define OLC_SIMD_AVX2
+	#endif
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define OLC_SIMD_SSE2
+	#endif
+#endif
+
+#if defined(OLC_SIMD_AVX2)
+	#include <immintrin.h>
+#elif defined(OLC_SIMD_SSE2)
+	#include <emmintrin.h>
+#endif
+
 // O------------------------------------------------------------------------------O
 // | PLATFORM SELECTION CODE, Thanks slavka!                                      |
 // O------------------------------------------------------------------------------O
 
 #if defined(OLC_PGE_HEADLESS)
 	#define OLC_PLATFORM_HEADLESS
-	#define OLC_GFX_HEADLESS
+	#if !defined(OLC_GFX_SOFTWARE)
+		#define OLC_GFX_HEADLESS
+	#endif
 	#if !defined(OLC_IMAGE_STB) && !defined(OLC_IMAGE_GDI) && !defined(OLC_IMAGE_LIBPNG)
 		#define OLC_IMAGE_HEADLESS
 	#endif
@@ -499,7 +522,7 @@ int main()
 
 
 // Renderer
-#if !defined(OLC_GFX_OPENGL10) && !defined(OLC_GFX_OPENGL33) && !defined(OLC_GFX_DIRECTX10) && !defined(OLC_GFX_HEADLESS)
+#if !defined(OLC_GFX_OPENGL10) && !defined(OLC_GFX_OPENGL33) && !defined(OLC_GFX_DIRECTX10) && !defined(OLC_GFX_HEADLESS) && !defined(OLC_GFX_SOFTWARE)
 	#if !defined(OLC_GFX_CUSTOM_EX)
 		#if defined(OLC_PLATFORM_EMSCRIPTEN)
 			#define OLC_GFX_OPENGL33
@@ -561,6 +584,9 @@ int main()
 		#include <X11/X.h>
 		#include <X11/Xlib.h>
 	}
+	#include <poll.h>
+	#include <fcntl.h>
+	#include <unistd.h>
 #endif
 
 #if defined(OLC_PLATFORM_GLUT)
@@ -914,6 +940,8 @@ namespace olc
 	constexpr uint32_t nDefaultPixel = uint32_t(nDefaultAlpha << 24);
 	constexpr uint8_t  nTabSizeInSpaces = 4;
 	constexpr size_t OLC_MAX_VERTS = 128;
+	constexpr size_t OLC_BATCH_VERTS = 65536;
+	constexpr size_t nMaxDirtyRegions = 4;
 	enum rcode { FAIL = 0, OK = 1, NO_FILE = -1 };
 
 	// O------------------------------------------------------------------------------O
@@ -1079,6 +1107,31 @@ namespace olc
 		std::vector<olc::Pixel> pColData;
 		Mode modeSample = Mode::NORMAL;
 
+	public:
+		// Dirty regions record what has changed since the sprite was last uploaded
+		// to a texture. Drawing via PGE, SetPixel() and GetData() maintain them, if
+		// you write to pColData directly, call MarkDirty() yourself
+		struct Region { olc::vi2d pos; olc::vi2d size; };
+		void MarkDirty();
+		void MarkDirty(int32_t x, int32_t y, int32_t w, int32_t h);
+		void ClearDirty();
+		bool IsDirty() const;
+		const std::vector<Region>& GetDirtyRegions() const;
+
+	public:
+		// Optional depth buffer, one float per pixel, used by FillTexturedMesh().
+		// Smaller values are nearer, cleared to "infinitely far away"
+		void EnableDepth(bool bEnable = true);
+		bool HasDepth() const;
+		float* GetDepth();
+		void ClearDepth(float fDepth = INFINITY);
+		std::vector<float> pDepthData;
+
+	private:
+		std::vector<Region> vDirty;
+
+	public:
+
 		static std::unique_ptr<olc::ImageLoader> loader;
 	};
 
@@ -1090,14 +1143,27 @@ namespace olc
 	public:
 		Decal(olc::Sprite* spr, bool filter = false, bool clamp = true);
 		Decal(const uint32_t nExistingTextureResource, olc::Sprite* spr);
+		// Shows only the area of another decal's texture at vPos of vSize pixels,
+		// sharing that texture, which must outlive this decal
+		Decal(olc::Decal* pSource, const olc::vi2d& vPos, const olc::vi2d& vSize);
 		virtual ~Decal();
 		void Update();
+		// Uploads only the dirty regions of the sprite, if any
+		void UpdateDirty();
 		void UpdateSprite();
 
 	public: // But dont touch
 		int32_t id = -1;
 		olc::Sprite* sprite = nullptr;
 		olc::vf2d vUVScale = { 1.0f, 1.0f };
+		// The area of the texture this decal shows, in texture coordinates, and its
+		// size in pixels. That is all of it, unless the decal shares its texture
+		olc::vf2d vUVOffset = { 0.0f, 0.0f };
+		olc::vf2d vUVSize = { 1.0f, 1.0f };
+		olc::vi2d vSize = { 0, 0 };
+
+	private:
+		bool bOwnsTexture = true;
 	};
 
 	enum class DecalMode
@@ -1118,6 +1184,19 @@ namespace olc
 		LIST
 	};
 
+	// One copy of a decal for DrawDecalInstanced(), placed as DrawPartialRotatedDecal()
+	// would place it. A source_size of zero shows the whole decal
+	struct DecalInstanceDesc
+	{
+		olc::vf2d pos = { 0.0f, 0.0f };
+		olc::vf2d scale = { 1.0f, 1.0f };
+		float angle = 0.0f;
+		olc::vf2d center = { 0.0f, 0.0f };
+		olc::vf2d source_pos = { 0.0f, 0.0f };
+		olc::vf2d source_size = { 0.0f, 0.0f };
+		olc::Pixel tint = olc::WHITE;
+	};
+
 	// O------------------------------------------------------------------------------O
 	// | olc::Renderable - Convenience class to keep a sprite and decal together      |
 	// O------------------------------------------------------------------------------O
@@ -1139,23 +1218,246 @@ namespace olc
 		std::unique_ptr<olc::Decal> pDecal = nullptr;
 	};
 
+	// O------------------------------------------------------------------------------O
+	// | olc::Atlas - Packs many sprites into a few large shared textures             |
+	// O------------------------------------------------------------------------------O
+	// Decals from the same page share one texture, so drawing them one after the
+	// other does not need a texture change. Sprites are copied into pages with a
+	// skyline packer. nPadding pixels are left around each one, and if bExtrude is
+	// set, its edge pixels are repeated into that padding, so filtering does not
+	// bleed in from neighbours. The atlas must be created after Construct()
+	class Atlas
+	{
+	public:
+		Atlas(const olc::vi2d& vPageSize = { 1024, 1024 }, int32_t nPadding = 1, bool bExtrude = true, bool filter = false);
+		Atlas(const Atlas&) = delete;
+		Atlas& operator=(const Atlas&) = delete;
+
+		// Copies spr into a page and returns a decal of just that area, which the
+		// decal drawing functions accept like any other. Returns nullptr if spr
+		// is bigger than a page. The decal belongs to the atlas
+		olc::Decal* Add(const olc::Sprite* spr);
+		size_t GetPageCount() const;
+		const olc::Renderable& GetPage(size_t nPage) const;
+		// Removes all pages, invalidating every decal returned by Add()
+		void Clear();
+
+	private:
+		struct Skyline { int32_t x, y, w; };
+		struct Page
+		{
+			olc::Renderable rPage;
+			std::vector<Skyline> vSkyline;
+		};
+
+		bool FindPosition(const Page& page, const olc::vi2d& vSize, olc::vi2d& vPos, size_t& nNode) const;
+		void Occupy(Page& page, size_t nNode, const olc::vi2d& vPos, const olc::vi2d& vSize);
+
+		olc::vi2d vPageSize;
+		int32_t nPadding = 1;
+		bool bExtrude = true;
+		bool bFilter = false;
+		std::vector<Page> vPages;
+		std::vector<std::unique_ptr<olc::Decal>> vDecals;
+	};
+
+	// O------------------------------------------------------------------------------O
+	// | olc::FrameWriter - Streams whole frames to a file or pipe                    |
+	// O------------------------------------------------------------------------------O
+	// Writes uncompressed YUV4MPEG2 (4:4:4, BT.601 limited range), which most video
+	// tools read directly, or raw RGBA with no header at all. Submitted frames are
+	// copied into one of two buffers and written out by a background thread, so
+	// Submit() only waits when the writer falls a whole frame behind. Every frame
+	// must be the size of the first. See PixelGameEngine::SetFrameWriter()
+	class FrameWriter
+	{
+	public:
+		enum class Format { Y4M, RGBA };
+
+		FrameWriter() = default;
+		FrameWriter(const FrameWriter&) = delete;
+		FrameWriter& operator=(const FrameWriter&) = delete;
+		~FrameWriter();
+
+		olc::rcode Open(const std::string& sFile, Format format = Format::Y4M, uint32_t nFPS = 60);
+		// Writes to an already open file or pipe, stdout or popen() for example,
+		// which Close() flushes but leaves open
+		olc::rcode Open(std::FILE* file, Format format = Format::Y4M, uint32_t nFPS = 60);
+		// Waits for queued frames to be written, then closes
+		void Close();
+		bool IsOpen() const;
+		// Queues a copy of frame. Returns false if nothing is open, a write has
+		// failed, or frame is not the size of the first. Call from one thread only
+		bool Submit(const olc::Sprite& frame);
+		uint64_t GetFramesWritten() const;
+
+	private:
+		void Writer();
+		bool WriteFrame(const std::vector<olc::Pixel>& vFrame);
+
+		std::FILE* pFile = nullptr;
+		bool bOwnsFile = false;
+		Format nFormat = Format::Y4M;
+		uint32_t nFPS = 60;
+		olc::vi2d vSize = { 0, 0 };
+		std::array<std::vector<olc::Pixel>, 2> vBuffers;
+		std::vector<uint8_t> vPlanes;
+		size_t nQueued = 0;
+		size_t nNextFill = 0;
+		size_t nNextWrite = 0;
+		bool bStop = false;
+		std::atomic<bool> bFailed{ false };
+		std::atomic<uint64_t> nFramesWritten{ 0 };
+		std::thread thWriter;
+		std::mutex muxQueue;
+		std::condition_variable cvQueued;
+		std::condition_variable cvFree;
+	};
+
+	// O------------------------------------------------------------------------------O
+	// | olc::Profiler - Scoped timing zones, exported as Chrome trace events         |
+	// O------------------------------------------------------------------------------O
+	// OLC_PROFILE_SCOPE("name") times the rest of the enclosing scope. Names must be
+	// string literals, or otherwise live as long as the program. Each thread records
+	// into its own ring of its last nRingSize zones without taking locks, and
+	// SaveTrace() writes what the rings hold as JSON for chrome://tracing or Perfetto.
+	// A zone costs one relaxed load while the profiler is disabled, and define
+	// OLC_PGE_NO_PROFILER to compile them out. See PixelGameEngine::EnableProfilerOverlay()
+	class Profiler
+	{
+	public:
+		struct Zone
+		{
+			const char* sName;
+			int64_t nStart;	// Nanoseconds, steady clock
+			int64_t nEnd;
+		};
+		static constexpr size_t nRingSize = 16384;
+
+		static void Enable(const bool bEnable = true);
+		static bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+		static int64_t Now();
+		static void Record(const char* sName, const int64_t nStart, const int64_t nEnd);
+		// Names the calling thread in saved traces
+		static void SetThreadName(const std::string& sName);
+		// Appends the zones, from every thread, that ended at or after nSince
+		static void GetZones(const int64_t nSince, std::vector<Zone>& vZones);
+		static olc::rcode SaveTrace(const std::string& sFile);
+
+	private:
+		// Relaxed atomics, as readers may look at a slot while it is rewritten
+		struct Slot
+		{
+			std::atomic<const char*> sName{ nullptr };
+			std::atomic<int64_t> nStart{ 0 };
+			std::atomic<int64_t> nEnd{ 0 };
+			void Store(const Zone& z);
+			Zone Load() const;
+		};
+		struct Ring
+		{
+			std::array<Slot, nRingSize> vZones;
+			std::atomic<uint64_t> nWritten{ 0 };
+			uint32_t nThread = 0;
+			std::string sName;
+		};
+		// Rings are created on a thread's first zone, and kept after it exits
+		static Ring* ThisThread();
+		static Ring*& ThisThreadRing();
+		static std::string& ThisThreadName();
+
+		static std::atomic<bool> bEnabled;
+		static std::mutex muxRings;
+		static std::vector<std::unique_ptr<Ring>> vRings;
+	};
+
+	// Times its own lifetime, see OLC_PROFILE_SCOPE()
+	class ProfileZone
+	{
+	public:
+		explicit ProfileZone(const char* sZone) : sName(Profiler::IsEnabled() ? sZone : nullptr), nStart(sName ? Profiler::Now() : 0) {}
+		~ProfileZone() { if (sName) Profiler::Record(sName, nStart, Profiler::Now()); }
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+
+	private:
+		const char* sName;
+		int64_t nStart;
+	};
+
+#if defined(OLC_PGE_NO_PROFILER)
+	#define OLC_PROFILE_SCOPE(name)
+#else
+	#define OLC_PROFILE_CONCAT_(a, b) a##b
+	#define OLC_PROFILE_CONCAT(a, b) OLC_PROFILE_CONCAT_(a, b)
+	#define OLC_PROFILE_SCOPE(name) olc::ProfileZone OLC_PROFILE_CONCAT(olc_profile_zone_, __LINE__)(name)
+#endif
+
 
 	// O------------------------------------------------------------------------------O
 	// | Auxilliary components internal to engine                                     |
 	// O------------------------------------------------------------------------------O
 
+	// An instanced copy of a decal, reduced to an affine transform in screen space.
+	// The quad corner c, in [0, 1] on each axis, is at origin + c.x * axisX + c.y * axisY
+	// and samples the texture at uvtl + c * (uvbr - uvtl)
+	struct DecalQuad
+	{
+		olc::vf2d origin;
+		olc::vf2d axisX;
+		olc::vf2d axisY;
+		olc::vf2d uvtl;
+		olc::vf2d uvbr;
+		olc::Pixel tint;
+	};
+
 	struct DecalInstance
 	{
 		olc::Decal* decal = nullptr;
+		// Views of this instance's vertices in its layer's DecalVertexArena
+		olc::vf2d* pos = nullptr;
+		olc::vf2d* uv = nullptr;
+		float* w = nullptr;
+		float* z = nullptr;
+		olc::Pixel* tint = nullptr;
+		olc::DecalMode mode = olc::DecalMode::NORMAL;
+		olc::DecalStructure structure = olc::DecalStructure::FAN;
+		uint32_t offset = 0;
+		uint32_t points = 0;
+		bool depth = false;
+		// Only for DrawDecalInstanced(), which has no points, just copies of a quad
+		olc::DecalQuad* instances = nullptr;
+		uint32_t instanceOffset = 0;
+		uint32_t instanceCount = 0;
+		// Draw order within a layer that sorts its decals, see EnableLayerDecalSort()
+		float key = 0.0f;
+		uint32_t order = 0;
+		// Scissor rectangle in normalised device coordinates, see PushClip()
+		olc::vf2d clipMin = { -1.0f, -1.0f };
+		olc::vf2d clipMax = { 1.0f, 1.0f };
+	};
+
+	// Per layer, per frame vertex storage shared by all of its decal instances.
+	// Cleared once the layer's decals are drawn, capacity is kept, so a steady
+	// state frame submits decals without allocating
+	struct DecalVertexArena
+	{
 		std::vector<olc::vf2d> pos;
 		std::vector<olc::vf2d> uv;
 		std::vector<float> w;
 		std::vector<float> z;
 		std::vector<olc::Pixel> tint;
-		olc::DecalMode mode = olc::DecalMode::NORMAL;
-		olc::DecalStructure structure = olc::DecalStructure::FAN;
-		uint32_t points = 0;
-		bool depth = false;
+		std::vector<olc::DecalQuad> quads;
+
+		// Reserves nPoints vertices with w and z set to 1. The returned views are
+		// only valid until the next Allocate(), Bind() refreshes them after that
+		olc::DecalInstance Allocate(const uint32_t nPoints);
+		// As above, but reserves nInstances quads for an instanced decal
+		olc::DecalInstance AllocateInstances(const uint32_t nInstances);
+		// Gives back the storage of the most recent allocation
+		void Release(const olc::DecalInstance& di);
+		const olc::DecalInstance& Bind(olc::DecalInstance& di);
+		void Clear();
 	};
 
 	struct LayerDesc
@@ -1167,10 +1469,48 @@ namespace olc
 		olc::Renderable pDrawTarget;
 		uint32_t nResID = 0;
 		std::vector<DecalInstance> vecDecalInstance;
+		DecalVertexArena decalArena;
+		bool bSortDecals = false;
 		olc::Pixel tint = olc::WHITE;
 		std::function<void()> funcHook = nullptr;
 	};
 
+	// Work a renderer has done since the engine last collected it
+	struct RendererStats
+	{
+		uint32_t nDrawCalls = 0;
+		uint32_t nTextureBinds = 0;
+		uint64_t nBytesUploaded = 0;	// Through UpdateTexture() and UpdateTextureRegion()
+	};
+
+	// Counters for the last complete frame, see PixelGameEngine::GetFrameStats()
+	struct FrameStats
+	{
+		static constexpr size_t nFrameHistory = 256;
+
+		// Pixels written to sprites, after clipping and the MASK alpha test,
+		// indexed by Pixel::Mode
+		std::array<uint64_t, 4> nPixelsDrawn{};
+		// Decals submitted to each layer, an instanced decal counts once per copy
+		struct Layer
+		{
+			uint32_t nDecals = 0;
+			uint64_t nVertices = 0;
+		};
+		std::vector<Layer> vLayers;
+		// With pipelined updates these trail the rest by a frame
+		olc::RendererStats renderer;
+		// Seconds. Engine time is the frame's work outside OnUserUpdate(), not
+		// counting waits for the frame rate limit, idle mode or the other thread
+		float fFrameTime = 0.0f;
+		float fUserUpdateTime = 0.0f;
+		float fEngineTime = 0.0f;
+		// Frame times over the last nFrameHistory frames
+		float fFrameTimeMin = 0.0f;
+		float fFrameTimeMean = 0.0f;
+		float fFrameTimeP99 = 0.0f;
+	};
+
 	class Renderer
 	{
 	public:
@@ -1183,13 +1523,30 @@ namespace olc
 		virtual void	   SetDecalMode(const olc::DecalMode& mode) = 0;
 		virtual void       DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) = 0;
 		virtual void       DrawDecal(const olc::DecalInstance& decal) = 0;
+		// Submits decals a renderer has batched, those that do not batch have none
+		virtual void       FlushDecals() {}
+		// Draws every quad of an instanced decal. Unless overridden, each one is
+		// passed to DrawDecal() as an ordinary four point decal
+		virtual void       DrawDecalInstanced(const olc::DecalInstance& decal);
 		virtual uint32_t   CreateTexture(const uint32_t width, const uint32_t height, const bool filtered = false, const bool clamp = true) = 0;
 		virtual void       UpdateTexture(uint32_t id, olc::Sprite* spr) = 0;
+		// Uploads part of a sprite. Unless overridden, the whole sprite is uploaded
+		virtual void       UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) { UNUSED(pos); UNUSED(size); UpdateTexture(id, spr); }
 		virtual void       ReadTexture(uint32_t id, olc::Sprite* spr) = 0;
 		virtual uint32_t   DeleteTexture(const uint32_t id) = 0;
 		virtual void       ApplyTexture(uint32_t id) = 0;
 		virtual void       UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) = 0;
 		virtual void       ClearBuffer(olc::Pixel p, bool bDepth) = 0;
+		// The frame most recently presented by DisplayFrame(), for renderers that
+		// compose it in memory. Others return nullptr
+		virtual const olc::Sprite* GetFrame() const { return nullptr; }
+		// Renderers that can stream texture uploads do so unless this is disabled
+		virtual void       SetAsyncUploads(bool bAsync) { UNUSED(bAsync); }
+		// Limits the decals that follow to a rectangle in normalised device
+		// coordinates, where { -1, -1 } to { 1, 1 } is the whole view
+		virtual void       SetDecalClip(const olc::vf2d& vMin, const olc::vf2d& vMax) { UNUSED(vMin); UNUSED(vMax); }
+		// Counted by each renderer, collected and reset by the engine every frame
+		olc::RendererStats stats;
 		static olc::PixelGameEngine* ptrPGE;
 	};
 
@@ -1208,6 +1565,14 @@ namespace olc
 		virtual olc::rcode SetWindowSize(const olc::vi2d& vWindowPos, const olc::vi2d& vWindowSize) = 0;
 		virtual olc::rcode StartSystemEventLoop() = 0;
 		virtual olc::rcode HandleSystemEvent() = 0;
+		// Blocks until HandleSystemEvent() has something to do, WakeSystemEvent() is
+		// called or fTimeout seconds pass, a negative timeout waits indefinitely.
+		// Platforms whose events arrive on another thread leave this as FAIL
+		virtual olc::rcode WaitSystemEvent(const float fTimeout) { UNUSED(fTimeout); return olc::rcode::FAIL; }
+		// Ends a WaitSystemEvent() in progress, from any thread
+		virtual void WakeSystemEvent() {}
+		// Discards wakes already acted upon, so the next wait does not end at once
+		virtual void ClearSystemEventWake() {}
 		static olc::PixelGameEngine* ptrPGE;
 	};
 
@@ -1287,8 +1652,46 @@ namespace olc
 		void SetDrawTarget(Sprite* target);
 		// Gets the current Frames Per Second
 		uint32_t GetFPS() const;
+		// Gets how many decals last frame were dropped for lying entirely off screen
+		uint32_t GetCulledDecalCount() const;
+		// Gets what the last frame drew and where its time went
+		const olc::FrameStats& GetFrameStats() const;
+		// Gets the last frame presented, or nullptr if the renderer does not keep it
+		// in memory. Headless applications get frames from OLC_GFX_SOFTWARE
+		const olc::Sprite* GetLastFrame() const;
+		// Submits every frame presented from now on to writer, nullptr stops
+		void SetFrameWriter(olc::FrameWriter* writer);
 		// Gets last update of elapsed time
 		float GetElapsedTime() const;
+		// Caps presentation at fFramesPerSecond, 0 is unlimited. The engine thread
+		// sleeps most of the wait and spins the remainder so frames stay evenly spaced
+		void SetFrameRateLimit(const float fFramesPerSecond);
+		float GetFrameRateLimit() const;
+		// Runs OnUserUpdate() at a fixed rate with fElapsedTime = 1 / fUpdatesPerSecond,
+		// as many times per presented frame as it takes to keep up, or not at all if
+		// no step is due yet. Decals then last until the next update rather than
+		// one frame. 0 restores one update per frame with measured time
+		void SetFixedUpdateRate(const float fUpdatesPerSecond);
+		// For applications that only change in response to input. After each frame
+		// the engine sleeps until a window or input event, RequestRedraw() or, if
+		// fWakeInterval is above 0, that many seconds have passed
+		void EnableIdleMode(const bool bEnable = true, const float fWakeInterval = 0.0f);
+		// Wakes an idle engine for another frame, safe to call from any thread
+		void RequestRedraw();
+		// Runs OnUserUpdate() for the next frame on its own thread while this thread
+		// draws and presents the last one. The graphics context stays here. Layer
+		// sprites and decal lists belong to the update thread; at each frame boundary,
+		// with both threads waiting, changed layers are uploaded and the decal lists
+		// are handed over. So:
+		//  - an olc::Decal must outlive the frame after the last one that draws it,
+		//    though creating, updating and deleting decals from OnUserUpdate() is fine
+		//  - layer render hooks run alongside the next OnUserUpdate()
+		//  - GetLastFrame() may be mid-draw, use a FrameWriter to see frames
+		// Frames run in sequence as usual while idle mode or manual rendering is on
+		void EnablePipelinedUpdate(const bool bEnable = true);
+		// Lists, over the top of layer 0, the time spent in each profiler zone
+		// during the previous frame. Enables the profiler, see olc::Profiler
+		void EnableProfilerOverlay(const bool bEnable = true);
 		// Gets Actual Window size
 		const olc::vi2d& GetWindowSize() const;
 		// Gets Actual Window position
@@ -1313,6 +1716,13 @@ namespace olc
 		void SetLayerScale(uint8_t layer, float x, float y);
 		void SetLayerTint(uint8_t layer, const olc::Pixel& tint);
 		void SetLayerCustomRenderFunction(uint8_t layer, std::function<void()> f);
+		// Draw the layer's decals by ascending sort key instead of in submission order.
+		// Decals sharing a key are grouped by texture, mode and structure, so they batch
+		void EnableLayerDecalSort(uint8_t layer, bool b);
+		// Layer and decal uploads are streamed where the renderer supports it, so the
+		// transfer overlaps drawing the next frame. Disabled, each upload is copied
+		// by the driver before the call returns
+		void SetAsyncTextureUploads(bool b);
 
 		std::vector<LayerDesc>& GetLayers();
 		uint32_t CreateLayer();
@@ -1325,6 +1735,9 @@ namespace olc
 		Pixel::Mode GetPixelMode();
 		// Use a custom blend function
 		void SetPixelMode(std::function<olc::Pixel(const int x, const int y, const olc::Pixel& pSource, const olc::Pixel& pDest)> pixelMode);
+		// Use a custom blend function that processes a whole horizontal run of
+		// count pixels at once, starting at (x,y), much cheaper than per pixel
+		void SetPixelModeSpan(std::function<void(const int x, const int y, const int32_t count, const olc::Pixel* pSource, olc::Pixel* pDest)> pixelMode);
 		// Change the blend factor from between 0.0f to 1.0f;
 		void SetPixelBlend(float fBlend);
 
@@ -1334,6 +1747,17 @@ namespace olc
 		void adv_HardwareClip(const bool bScale, const olc::vi2d& viewPos, const olc::vi2d& viewSize, const bool bClear = false);
 		void adv_FlushLayer(const size_t nLayerID);
 		void adv_FlushLayerDecals(const size_t nLayerID);
+		// Deferred drawing - drawing to layers is recorded during the frame and
+		// rasterised in parallel, in horizontal tiles, just before the layers are
+		// uploaded. Layer pixels are stale until then, so flush before reading them.
+		// CUSTOM pixel mode functions must be thread safe. nWorkers = 0 picks a
+		// worker count from the hardware.
+		void adv_DeferredDrawEnable(const bool bEnable, const uint32_t nWorkers = 0);
+		void adv_FlushDeferredDraw();
+		// Calls func on the thread that owns the renderer, and waits for it. That
+		// is only ever another thread with pipelined updates, where renderer calls
+		// from OnUserUpdate() must go through here. olc::Decal already does
+		void adv_RunOnRenderThread(const std::function<void()>& func);
 
 	public: // DRAWING ROUTINES
 		// Draws a single Pixel
@@ -1361,8 +1785,17 @@ namespace olc
 		void FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p = olc::WHITE);
 		void FillTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p = olc::WHITE);
 		// Fill a textured and coloured triangle
-		void FillTexturedTriangle(std::vector<olc::vf2d> vPoints, std::vector<olc::vf2d> vTex, std::vector<olc::Pixel> vColour, olc::Sprite* sprTex);
+		void FillTexturedTriangle(const std::vector<olc::vf2d>& vPoints, const std::vector<olc::vf2d>& vTex, const std::vector<olc::Pixel>& vColour, olc::Sprite* sprTex);
 		void FillTexturedPolygon(const std::vector<olc::vf2d>& vPoints, const std::vector<olc::vf2d>& vTex, const std::vector<olc::Pixel>& vColour, olc::Sprite* sprTex, olc::DecalStructure structure = olc::DecalStructure::LIST);
+		// As above, but from raw arrays of 3 (triangle) or nVertices (polygon) elements, so
+		// nothing is allocated. If pIndices is given, nIndices indices select the vertices
+		void FillTexturedTriangle(const olc::vf2d* pPoints, const olc::vf2d* pTex, const olc::Pixel* pColour, olc::Sprite* sprTex);
+		void FillTexturedPolygon(const olc::vf2d* pPoints, const olc::vf2d* pTex, const olc::Pixel* pColour, size_t nVertices, olc::Sprite* sprTex, olc::DecalStructure structure = olc::DecalStructure::LIST, const uint32_t* pIndices = nullptr, size_t nIndices = 0);
+		// Fill an indexed triangle list (every vertex in order if there are no indices),
+		// depth testing per pixel against the draw target's depth buffer, if it has one,
+		// before anything is shaded. Back faces, anticlockwise on screen, can be culled
+		void FillTexturedMesh(const std::vector<olc::vf2d>& vPoints, const std::vector<olc::vf2d>& vTex, const std::vector<olc::Pixel>& vColour, const std::vector<uint32_t>& vIndices, const std::vector<float>& vDepth, olc::Sprite* sprTex, bool bCullBackFaces = false);
+		void FillTexturedMesh(const olc::vf2d* pPoints, const olc::vf2d* pTex, const olc::Pixel* pColour, size_t nVertices, const uint32_t* pIndices, size_t nIndices, const float* pDepth, olc::Sprite* sprTex, bool bCullBackFaces = false);
 		// Draws an entire sprite at location (x,y)
 		void DrawSprite(int32_t x, int32_t y, Sprite* sprite, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE);
 		void DrawSprite(const olc::vi2d& pos, Sprite* sprite, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE);
@@ -1382,6 +1815,10 @@ namespace olc
 		// Decal Quad functions
 		void SetDecalMode(const olc::DecalMode& mode);
 		void SetDecalStructure(const olc::DecalStructure& structure);
+		// Sets the key given to subsequent decals, lower keys are drawn first. Only
+		// used by layers with EnableLayerDecalSort(), for depth or explicit ordering.
+		// NaN has no order, so it is taken as 0
+		void SetDecalSortKey(const float fKey);
 		// Draws a whole decal, with optional scale and tinting
 		void DrawDecal(const olc::vf2d& pos, olc::Decal* decal, const olc::vf2d& scale = { 1.0f,1.0f }, const olc::Pixel& tint = olc::WHITE);
 		// Draws a region of a decal, with optional scale and tinting
@@ -1400,6 +1837,9 @@ namespace olc
 		// Draws a decal rotated to specified angle, wit point of rotation offset
 		void DrawRotatedDecal(const olc::vf2d& pos, olc::Decal* decal, const float fAngle, const olc::vf2d& center = { 0.0f, 0.0f }, const olc::vf2d& scale = { 1.0f,1.0f }, const olc::Pixel& tint = olc::WHITE);
 		void DrawPartialRotatedDecal(const olc::vf2d& pos, olc::Decal* decal, const float fAngle, const olc::vf2d& center, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::vf2d& scale = { 1.0f, 1.0f }, const olc::Pixel& tint = olc::WHITE);
+		// Draws many copies of a decal at once, each with its own placement and tint
+		void DrawDecalInstanced(olc::Decal* decal, const olc::DecalInstanceDesc* pInstances, size_t nInstances);
+		void DrawDecalInstanced(olc::Decal* decal, const std::vector<olc::DecalInstanceDesc>& vInstances);
 		// Draws a multiline string as a decal, with tiniting and scaling
 		void DrawStringDecal(const olc::vf2d& pos, const std::string& sText, const Pixel col = olc::WHITE, const olc::vf2d& scale = { 1.0f, 1.0f });
 		void DrawStringPropDecal(const olc::vf2d& pos, const std::string& sText, const Pixel col = olc::WHITE, const olc::vf2d& scale = { 1.0f, 1.0f });
@@ -1430,8 +1870,14 @@ namespace olc
 		// Returns the font image
 		olc::Sprite* GetFontSprite();
 
-		// Clip a line segment to visible area
+		// Clip a line segment to visible area, or to the clip rectangle if one is set
 		bool ClipLineToScreen(olc::vi2d& in_p1, olc::vi2d& in_p2);
+		// Limit drawing, decals included, to where this rectangle overlaps the clip
+		// already in force, until the matching PopClip(). Positions are in screen
+		// pixels, which for layers are also draw target pixels
+		void PushClip(const olc::vi2d& pos, const olc::vi2d& size);
+		void PushClip(int32_t x, int32_t y, int32_t w, int32_t h);
+		void PopClip();
 
 		// Dont allow PGE to mark layers as dirty, so pixel graphics don't update
 		void EnablePixelTransfer(const bool bEnable = true);
@@ -1455,6 +1901,58 @@ namespace olc
 		void UpdateTextEntry();
 		void UpdateConsole();
 
+		// Writes a horizontal run of w pixels starting at (x,y), clipped to the
+		// draw target and clip rectangle, honouring the current pixel mode - all fills route here
+		void FillSpan(int32_t x, int32_t y, int32_t w, Pixel p);
+		// As above, but each pixel of the run is taken from the source row pSrc
+		void DrawSpan(int32_t x, int32_t y, int32_t w, const Pixel* pSrc);
+		// Span writers specialised for a pixel mode policy (see olc::pixelmode)
+		template<typename Mode> void FillSpan(const Mode& mode, int32_t x, int32_t y, int32_t w, Pixel p);
+		template<typename Mode> void DrawSpan(const Mode& mode, int32_t x, int32_t y, int32_t w, const Pixel* pSrc);
+		// Resolves the current pixel mode once, and invokes f with its policy, so
+		// primitives are instantiated per mode with branch free inner loops
+		template<typename F> void DispatchPixelMode(F&& f);
+		// Half-space triangle rasteriser, calls fnSpan(y, x0, x1) for each row of
+		// covered pixels [x0, x1). Pixels are sampled at integer coordinates, and
+		// vertices snap to a fixed point grid with a top-left fill rule
+		template<typename F> void RasteriseTriangle(const olc::vf2d& v0, const olc::vf2d& v1, const olc::vf2d& v2, F&& fnSpan);
+		// The same, for vertices already snapped to fixed point by raster::SnapTriangle()
+		template<typename F> void RasteriseSnapped(int64_t x0, int64_t y0, int64_t x1, int64_t y1, int64_t x2, int64_t y2, F& fnSpan);
+		// Interpolates colour, texture and, if pDepth is given, depth across a triangle
+		void ShadeTriangle(const olc::vf2d* pPos, const olc::vf2d* pTex, const olc::Pixel* pCol, const float* pDepth, olc::Sprite* sprTex);
+		// Reserves vertices for a decal on the target layer, with the current decal mode and structure
+		olc::DecalInstance AllocateDecal(olc::Decal* decal, const uint32_t nPoints);
+		// Adds a decal to the target layer, unless it cannot touch the view
+		void SubmitDecal(olc::DecalInstance& di);
+		// Sends a layer's decals to the renderer, then empties the layer
+		void DrawLayerDecals(olc::LayerDesc& layer);
+		// Sets a quad's texture coordinates to the area of the texture decal shows
+		void SetDecalUV(olc::DecalInstance& di, const olc::Decal* decal) const;
+		// Writes a glyph mask (bit = row * 8 + column) as runs of spans, scaled
+		template<typename Mode> void DrawGlyph(const Mode& mode, int32_t x, int32_t y, uint64_t nMask, Pixel col, int32_t scale);
+		// The drawable part of the draw target, [ClipMin(), ClipMax()), which is
+		// empty if there is no draw target or the clip misses it
+		olc::vi2d ClipMin() const;
+		olc::vi2d ClipMax() const;
+
+		// Deferred drawing, spans are recorded into tiles and rasterised by workers
+		struct DeferredSpan
+		{
+			olc::Sprite* pTarget;
+			int32_t x, y, w;
+			Pixel::Mode nMode;
+			uint32_t nParam;	// ALPHA: blend factor, CUSTOM: function snapshot
+			Pixel p;			// Fill colour if there is no source
+			uint32_t nSource;	// Offset into vDeferredSource, or nDeferredNoSource
+		};
+		static constexpr uint32_t nDeferredNoSource = 0xFFFFFFFF;
+		static constexpr int32_t nDeferredTileHeight = 16;
+		template<typename Mode> void DeferSpan(const Mode& mode, int32_t x, int32_t y, int32_t w, Pixel p, const Pixel* pSrc);
+		bool IsDeferring() const;
+		void DeferredWorker(uint64_t nJob);
+		void DeferredRasterise();
+		void DeferredStopWorkers();
+
 	public:
 
 		// Experimental Lightweight 3D Routines ================
@@ -1520,13 +2018,94 @@ namespace olc
 		std::vector<LayerDesc> vLayers;
 		uint8_t		nTargetLayer = 0;
 		uint32_t	nLastFPS = 0;
+		uint32_t	nDecalsCulled = 0;
+		uint32_t	nLastDecalsCulled = 0;
+		// Frame statistics, see GetFrameStats(). Counted into statsFrame, except for
+		// render thread time, and collected into statsLast by EndFrame()
+		olc::FrameStats statsFrame;
+		olc::FrameStats statsLast;
+		float		fRenderTime = 0.0f;
+		std::array<float, olc::FrameStats::nFrameHistory> vFrameTimes{};
+		size_t		nFrameTimes = 0;
+		olc::FrameWriter* pFrameWriter = nullptr;
 		bool		bManualRenderEnable = false;
 		bool        bPixelCohesion = false;
 		DecalMode   nDecalMode = DecalMode::NORMAL;
 		DecalStructure nDecalStructure = DecalStructure::FAN;
+		float		fDecalSortKey = 0.0f;
+		// Intersection of every rectangle on the clip stack, [vClipMin, vClipMax)
+		std::vector<std::pair<olc::vi2d, olc::vi2d>> vClipStack;
+		olc::vi2d	vClipMin = { 0, 0 };
+		olc::vi2d	vClipMax = { INT32_MAX, INT32_MAX };
 		std::function<olc::Pixel(const int x, const int y, const olc::Pixel&, const olc::Pixel&)> funcPixelMode;
-		std::chrono::time_point<std::chrono::system_clock> m_tp1, m_tp2;
+		std::function<void(const int x, const int y, const int32_t count, const olc::Pixel*, olc::Pixel*)> funcPixelModeSpan;
+		std::chrono::time_point<std::chrono::steady_clock> m_tp1, m_tp2;
+		// Frame pacing, see SetFrameRateLimit(). The margin is how early sleeps
+		// end, following recent oversleeps so the spin absorbs them
+		float		fFrameRateLimit = 0.0f;
+		std::chrono::time_point<std::chrono::steady_clock> tpNextFrame;
+		std::chrono::duration<double> dSleepMargin = std::chrono::microseconds(500);
+		// Fixed timestep, see SetFixedUpdateRate(). Past nMaxFixedUpdates in one
+		// frame the time owed is dropped rather than chased
+		float		fFixedStep = 0.0f;
+		float		fFixedTimeOwed = 0.0f;
+		static constexpr uint32_t nMaxFixedUpdates = 8;
+		// Idle mode, see EnableIdleMode(). Anything arriving after a frame has
+		// taken its input sets bIdleWake, so the wait that follows is skipped
+		std::atomic<bool> bIdleMode{ false };
+		float		fIdleWakeInterval = 0.0f;
+		std::mutex	muxIdle;
+		std::condition_variable cvIdle;
+		bool		bIdleWake = false;
+		// Pipelined updates, see EnablePipelinedUpdate(). A layer as the render
+		// thread draws it, everything but its draw target copied at the boundary
+		struct PipelinedLayer
+		{
+			olc::LayerDesc desc;
+			int32_t nTextureID = -1;
+		};
+		std::atomic<bool> bPipelined{ false };
+		bool		bPipelineRunning = false;
+		std::thread::id idRenderThread;
+		std::mutex	muxPipeline;
+		std::condition_variable cvPipeline;
+		bool		bUpdateGo = false;
+		bool		bUpdateReady = false;
+		bool		bUpdateQuit = false;
+		std::vector<std::pair<const std::function<void()>*, bool*>> vRenderCalls;
+		std::vector<PipelinedLayer> vPipelinedLayers;
+		olc::vi2d	vPipelinedViewPos;
+		olc::vi2d	vPipelinedViewSize;
+		// Whether layers keep their decals once drawn, as a fixed timestep needs.
+		// Taken when the frame is handed to the renderer, which may run alongside
+		// a SetFixedUpdateRate()
+		bool		bKeepLayerDecals = false;
+		// Profiler overlay, see EnableProfilerOverlay()
+		bool		bProfilerOverlay = false;
+		int64_t		nProfileFrameStart = 0;
 		std::vector<olc::vi2d> vFontSpacing;
+		// One bit per texel, fixed width glyphs, and glyphs pre-shifted to their proportional width
+		std::array<uint64_t, 96> vFontMask{};
+		std::array<uint64_t, 96> vFontMaskProp{};
+		std::vector<olc::Pixel> vSpanBuffer;
+		std::vector<olc::Pixel> vSpanFill;
+		uint32_t nCustomModeVersion = 0;
+
+		// Deferred Drawing Specific
+		bool bDeferredDraw = false;
+		bool bDrawTargetIsLayer = false;
+		std::vector<std::vector<DeferredSpan>> vDeferredTiles;
+		std::vector<olc::Pixel> vDeferredSource;
+		std::vector<std::pair<decltype(funcPixelMode), decltype(funcPixelModeSpan)>> vDeferredCustom;
+		uint32_t nDeferredCustomVersion = 0xFFFFFFFF;
+		std::vector<std::thread> vDeferredWorkers;
+		std::mutex muxDeferred;
+		std::condition_variable cvDeferredWork;
+		std::condition_variable cvDeferredDone;
+		uint64_t nDeferredJob = 0;
+		size_t nDeferredBusy = 0;
+		bool bDeferredQuit = false;
+		std::atomic<size_t> nDeferredNextTile{ 0 };
 		std::vector<std::string> vDroppedFiles;
 		std::vector<std::string> vDroppedFilesCache;
 		olc::vi2d vDroppedFilesPoint;
@@ -1565,6 +2144,28 @@ namespace olc
 
 		// The main engine thread
 		void		EngineThread();
+		// Waits out the rest of the frame under a frame rate limit
+		void		PaceFrame();
+		// Sleeps between frames in idle mode, SignalIdle() ends the sleep
+		void		IdleWait();
+		void		SignalIdle();
+		void		WakeIdle();
+		// The two halves of olc_CoreUpdate(). UpdateFrame() takes input and runs the
+		// user update, then RenderFrame() uploads layers, draws and presents
+		void		UpdateFrame();
+		void		RenderFrame();
+		// Pieces of RenderFrame() that pipelined updates split across threads
+		void		UploadLayers();
+		void		DrawLayer(olc::LayerDesc& layer, const int32_t nTextureID);
+		void		PresentFrame();
+		void		EndFrame();
+		void		CollectFrameStats();
+		// Runs frames with OnUserUpdate() on a thread of its own, for as long as
+		// pipelining is possible, see EnablePipelinedUpdate()
+		void		RunPipelined();
+		void		PipelinedUpdateThread();
+		void		ServiceRenderCalls(std::unique_lock<std::mutex>& lock);
+		void		DrawProfilerOverlay(const int64_t nFrom, const int64_t nTo);
 
 
 		// If anything sets this flag to false, the engine
@@ -1675,6 +2276,8 @@ namespace olc
 {
 	typedef char GLchar;
 	typedef ptrdiff_t GLsizeiptr;
+	typedef ptrdiff_t GLintptr;
+	typedef struct __GLsync* GLsync;
 
 	typedef GLuint CALLSTYLE locCreateShader_t(GLenum type);
 	typedef GLuint CALLSTYLE locCreateProgram_t(void);
@@ -1685,6 +2288,7 @@ namespace olc
 	typedef void CALLSTYLE locAttachShader_t(GLuint program, GLuint shader);
 	typedef void CALLSTYLE locBindBuffer_t(GLenum target, GLuint buffer);
 	typedef void CALLSTYLE locBufferData_t(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+	typedef void CALLSTYLE locBufferSubData_t(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
 	typedef void CALLSTYLE locGenBuffers_t(GLsizei n, GLuint* buffers);
 	typedef void CALLSTYLE locVertexAttribPointer_t(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
 	typedef void CALLSTYLE locEnableVertexAttribArray_t(GLuint index);
@@ -1704,6 +2308,14 @@ namespace olc
 	typedef void CALLSTYLE locFrameBufferTexture2D_t(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
 	typedef void CALLSTYLE locDrawBuffers_t(GLsizei n, const GLenum* bufs);
 	typedef void CALLSTYLE locBlendFuncSeparate_t(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+	typedef void CALLSTYLE locVertexAttribDivisor_t(GLuint index, GLuint divisor);
+	typedef void CALLSTYLE locDrawArraysInstanced_t(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+	typedef void* CALLSTYLE locMapBufferRange_t(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+	typedef GLboolean CALLSTYLE locUnmapBuffer_t(GLenum target);
+	typedef GLsync CALLSTYLE locFenceSync_t(GLenum condition, GLbitfield flags);
+	typedef GLenum CALLSTYLE locClientWaitSync_t(GLsync sync, GLbitfield flags, uint64_t timeout);
+	typedef void CALLSTYLE locDeleteSync_t(GLsync sync);
+	typedef void CALLSTYLE locTexStorage2D_t(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
 
 #if defined(OLC_PLATFORM_WINAPI)
 	typedef void __stdcall locSwapInterval_t(GLsizei n);
@@ -1874,6 +2486,8 @@ namespace olc
 	{
 		width = w;		height = h;
 		pColData.resize(width * height, nDefaultPixel);
+		if (HasDepth()) pDepthData.resize(width * height, INFINITY);
+		MarkDirty();
 	}
 
 	Sprite::~Sprite()
@@ -1911,6 +2525,7 @@ namespace olc
 		if (x >= 0 && x < width && y >= 0 && y < height)
 		{
 			pColData[y * width + x] = p;
+			MarkDirty(x, y, 1, 1);
 			return true;
 		}
 		else
@@ -1957,7 +2572,11 @@ namespace olc
 	}
 
 	Pixel* Sprite::GetData()
-	{ return pColData.data(); }
+	{
+		// The caller may write anywhere through this, so all of it is uploaded
+		MarkDirty();
+		return pColData.data();
+	}
 
 
 	olc::rcode Sprite::LoadFromFile(const std::string& sImageFile, olc::ResourcePack* pack)
@@ -1969,7 +2588,7 @@ namespace olc
 	olc::Sprite* Sprite::Duplicate()
 	{
 		olc::Sprite* spr = new olc::Sprite(width, height);
-		std::memcpy(spr->GetData(), GetData(), width * height * sizeof(olc::Pixel));
+		std::memcpy(spr->pColData.data(), pColData.data(), width * height * sizeof(olc::Pixel));
 		spr->modeSample = modeSample;
 		return spr;
 	}
@@ -1988,15 +2607,99 @@ namespace olc
 		return { width, height };
 	}
 
+	void Sprite::MarkDirty()
+	{
+		vDirty.clear();
+		if (width > 0 && height > 0)
+			vDirty.push_back({ { 0, 0 }, { width, height } });
+	}
+
+	void Sprite::MarkDirty(int32_t x, int32_t y, int32_t w, int32_t h)
+	{
+		// Clip to sprite
+		int32_t x2 = std::min(x + w, width), y2 = std::min(y + h, height);
+		x = std::max(x, 0); y = std::max(y, 0);
+		if (x >= x2 || y >= y2) return;
+
+		// Already covered? Most calls land in a region a primitive marked up front
+		for (const auto& r : vDirty)
+			if (x >= r.pos.x && y >= r.pos.y && x2 <= r.pos.x + r.size.x && y2 <= r.pos.y + r.size.y)
+				return;
+
+		if (vDirty.size() < nMaxDirtyRegions)
+		{
+			vDirty.push_back({ { x, y }, { x2 - x, y2 - y } });
+			return;
+		}
+
+		// Out of regions, so grow whichever one gains the least area by absorbing this
+		size_t nBest = 0;
+		int64_t nBestGrowth = INT64_MAX;
+		for (size_t i = 0; i < vDirty.size(); i++)
+		{
+			const auto& r = vDirty[i];
+			int64_t w2 = std::max(x2, r.pos.x + r.size.x) - std::min(x, r.pos.x);
+			int64_t h2 = std::max(y2, r.pos.y + r.size.y) - std::min(y, r.pos.y);
+			int64_t nGrowth = w2 * h2 - int64_t(r.size.x) * int64_t(r.size.y);
+			if (nGrowth < nBestGrowth) { nBestGrowth = nGrowth; nBest = i; }
+		}
+
+		Region g = vDirty[nBest];
+		x2 = std::max(x2, g.pos.x + g.size.x); y2 = std::max(y2, g.pos.y + g.size.y);
+		g.pos = { std::min(x, g.pos.x), std::min(y, g.pos.y) };
+		g.size = { x2 - g.pos.x, y2 - g.pos.y };
+
+		// The grown region may now swallow others
+		vDirty.erase(std::remove_if(vDirty.begin(), vDirty.end(), [&](const Region& r)
+		{
+			return r.pos.x >= g.pos.x && r.pos.y >= g.pos.y && r.pos.x + r.size.x <= x2 && r.pos.y + r.size.y <= y2;
+		}), vDirty.end());
+		vDirty.push_back(g);
+	}
+
+	void Sprite::ClearDirty()
+	{ vDirty.clear(); }
+
+	void Sprite::EnableDepth(bool bEnable)
+	{
+		if (bEnable)
+			pDepthData.assign(size_t(width) * size_t(height), INFINITY);
+		else
+			pDepthData.clear();
+	}
+
+	bool Sprite::HasDepth() const
+	{ return !pDepthData.empty(); }
+
+	float* Sprite::GetDepth()
+	{ return pDepthData.data(); }
+
+	void Sprite::ClearDepth(float fDepth)
+	{ std::fill(pDepthData.begin(), pDepthData.end(), fDepth); }
+
+	bool Sprite::IsDirty() const
+	{ return !vDirty.empty(); }
+
+	const std::vector<Sprite::Region>& Sprite::GetDirtyRegions() const
+	{ return vDirty; }
+
 	// O------------------------------------------------------------------------------O
 	// | olc::Decal IMPLEMENTATION                                                    |
 	// O------------------------------------------------------------------------------O
+	// Texture work is done on the thread that owns the renderer, which is not the
+	// one running OnUserUpdate() with pipelined updates
+	static void OnRenderThread(const std::function<void()>& func)
+	{
+		if (Renderer::ptrPGE != nullptr) Renderer::ptrPGE->adv_RunOnRenderThread(func);
+		else func();
+	}
+
 	Decal::Decal(olc::Sprite* spr, bool filter, bool clamp)
 	{
 		id = -1;
 		if (spr == nullptr) return;
 		sprite = spr;
-		id = renderer->CreateTexture(sprite->width, sprite->height, filter, clamp);
+		OnRenderThread([&] { id = renderer->CreateTexture(sprite->width, sprite->height, filter, clamp); });
 		Update();
 	}
 
@@ -2006,26 +2709,59 @@ namespace olc
 		id = nExistingTextureResource;
 	}
 
+	Decal::Decal(olc::Decal* pSource, const olc::vi2d& vPos, const olc::vi2d& vSize)
+	{
+		if (pSource == nullptr) return;
+		id = pSource->id;
+		sprite = pSource->sprite;
+		bOwnsTexture = false;
+		vUVScale = pSource->vUVScale;
+		vUVOffset = pSource->vUVOffset + olc::vf2d(vPos) * vUVScale;
+		vUVSize = olc::vf2d(vSize) * vUVScale;
+		this->vSize = vSize;
+	}
+
 	void Decal::Update()
 	{
 		if (sprite == nullptr) return;
 		vUVScale = { 1.0f / float(sprite->width), 1.0f / float(sprite->height) };
-		renderer->ApplyTexture(id);
-		renderer->UpdateTexture(id, sprite);
+		if (bOwnsTexture) vSize = sprite->Size();
+		OnRenderThread([&]
+		{
+			renderer->ApplyTexture(id);
+			renderer->UpdateTexture(id, sprite);
+		});
+		sprite->ClearDirty();
+	}
+
+	void Decal::UpdateDirty()
+	{
+		if (sprite == nullptr || !sprite->IsDirty()) return;
+		OnRenderThread([&]
+		{
+			renderer->ApplyTexture(id);
+			for (const auto& r : sprite->GetDirtyRegions())
+				renderer->UpdateTextureRegion(id, sprite, r.pos, r.size);
+		});
+		sprite->ClearDirty();
 	}
 
 	void Decal::UpdateSprite()
 	{
 		if (sprite == nullptr) return;
-		renderer->ApplyTexture(id);
-		renderer->ReadTexture(id, sprite);
+		OnRenderThread([&]
+		{
+			renderer->ApplyTexture(id);
+			renderer->ReadTexture(id, sprite);
+		});
+		sprite->ClearDirty();
 	}
 
 	Decal::~Decal()
 	{
-		if (id != -1)
+		if (id != -1 && bOwnsTexture)
 		{
-			renderer->DeleteTexture(id);
+			OnRenderThread([&] { renderer->DeleteTexture(id); });
 			id = -1;
 		}
 	}
@@ -2059,179 +2795,984 @@ namespace olc
 	{ return pSprite.get(); }
 
 	// O------------------------------------------------------------------------------O
-	// | olc::ResourcePack IMPLEMENTATION                                             |
+	// | olc::Atlas IMPLEMENTATION                                                    |
 	// O------------------------------------------------------------------------------O
+	Atlas::Atlas(const olc::vi2d& vPageSize, int32_t nPadding, bool bExtrude, bool filter)
+		: vPageSize(vPageSize), nPadding(std::max(nPadding, 0)), bExtrude(bExtrude), bFilter(filter)
+	{ }
 
-
-	//=============================================================
-	// Resource Packs - Allows you to store files in one large 
-	// scrambled file - Thanks MaGetzUb for debugging a null char in std::stringstream bug
-	ResourceBuffer::ResourceBuffer(std::ifstream& ifs, uint32_t offset, uint32_t size)
+	olc::Decal* Atlas::Add(const olc::Sprite* spr)
 	{
-		vMemory.resize(size);
-		ifs.seekg(offset); ifs.read(vMemory.data(), vMemory.size());
-		setg(vMemory.data(), vMemory.data(), vMemory.data() + size);
-	}
+		if (spr == nullptr || spr->width <= 0 || spr->height <= 0) return nullptr;
 
-	ResourcePack::ResourcePack() { }
-	ResourcePack::~ResourcePack() { baseFile.close(); }
+		// Each sprite occupies a slot, itself plus the padding all around it
+		const olc::vi2d vSlot = spr->Size() + olc::vi2d(nPadding, nPadding) * 2;
+		if (vSlot.x > vPageSize.x || vSlot.y > vPageSize.y) return nullptr;
 
-	bool ResourcePack::AddFile(const std::string& sFile)
-	{
-		const std::string file = makeposix(sFile);
+		olc::vi2d vPos;
+		size_t nNode = 0;
+		auto page = std::find_if(vPages.begin(), vPages.end(),
+			[&](const Page& p) { return FindPosition(p, vSlot, vPos, nNode); });
 
-		if (_gfs::exists(file))
+		if (page == vPages.end())
 		{
-			sResourceFile e;
-			e.nSize = (uint32_t)_gfs::file_size(file);
-			e.nOffset = 0; // Unknown at this stage			
-			mapFiles[file] = e;
-			return true;
+			vPages.emplace_back();
+			page = std::prev(vPages.end());
+			page->rPage.Create(vPageSize.x, vPageSize.y, bFilter, true);
+			std::fill(page->rPage.Sprite()->pColData.begin(), page->rPage.Sprite()->pColData.end(), olc::BLANK);
+			page->rPage.Decal()->Update();
+			page->vSkyline = { { 0, 0, vPageSize.x } };
+			FindPosition(*page, vSlot, vPos, nNode);
 		}
-		return false;
-	}
 
-	bool ResourcePack::LoadPack(const std::string& sFile, const std::string& sKey)
-	{
-		// Open the resource file
-		baseFile.open(sFile, std::ifstream::binary);
-		if (!baseFile.is_open()) return false;
+		Occupy(*page, nNode, vPos, vSlot);
 
-		// 1) Read Scrambled index
-		uint32_t nIndexSize = 0;
-		baseFile.read((char*)&nIndexSize, sizeof(uint32_t));
+		// Copy the sprite into the centre of its slot, and fill the padding
+		// with either its nearest edge pixels or nothing
+		olc::Sprite* pPage = page->rPage.Sprite();
+		for (int32_t y = 0; y < vSlot.y; y++)
+		{
+			const int32_t sy = y - nPadding;
+			olc::Pixel* pDst = pPage->pColData.data() + size_t(vPos.y + y) * size_t(vPageSize.x) + vPos.x;
+			for (int32_t x = 0; x < vSlot.x; x++)
+			{
+				const int32_t sx = x - nPadding;
+				if (sx >= 0 && sx < spr->width && sy >= 0 && sy < spr->height)
+					pDst[x] = spr->pColData[size_t(sy) * size_t(spr->width) + sx];
+				else if (bExtrude)
+					pDst[x] = spr->pColData[size_t(std::clamp(sy, 0, spr->height - 1)) * size_t(spr->width) + std::clamp(sx, 0, spr->width - 1)];
+				else
+					pDst[x] = olc::BLANK;
+			}
+		}
+		pPage->MarkDirty(vPos.x, vPos.y, vSlot.x, vSlot.y);
+		page->rPage.Decal()->UpdateDirty();
 
-		std::vector<char> buffer(nIndexSize);
-		for (uint32_t j = 0; j < nIndexSize; j++)
-			buffer[j] = baseFile.get();
+		vDecals.push_back(std::make_unique<olc::Decal>(page->rPage.Decal(), vPos + olc::vi2d(nPadding, nPadding), spr->Size()));
+		return vDecals.back().get();
+	}
 
-		std::vector<char> decoded = scramble(buffer, sKey);
-		size_t pos = 0;
-		auto read = [&decoded, &pos](char* dst, size_t size) {
-			memcpy((void*)dst, (const void*)(decoded.data() + pos), size);
-			pos += size;
-		};
+	size_t Atlas::GetPageCount() const
+	{ return vPages.size(); }
 
-		auto get = [&read]() -> int { char c; read(&c, 1); return c; };
+	const olc::Renderable& Atlas::GetPage(size_t nPage) const
+	{ return vPages[nPage].rPage; }
 
-		// 2) Read Map
-		uint32_t nMapEntries = 0;
-		read((char*)&nMapEntries, sizeof(uint32_t));
-		for (uint32_t i = 0; i < nMapEntries; i++)
+	void Atlas::Clear()
+	{
+		vDecals.clear();
+		vPages.clear();
+	}
+
+	// Bottom left skyline search, the slot goes where its top edge is lowest
+	bool Atlas::FindPosition(const Page& page, const olc::vi2d& vSize, olc::vi2d& vPos, size_t& nNode) const
+	{
+		int32_t nBestY = INT32_MAX;
+		for (size_t i = 0; i < page.vSkyline.size(); i++)
 		{
-			uint32_t nFilePathSize = 0;
-			read((char*)&nFilePathSize, sizeof(uint32_t));
+			const int32_t x = page.vSkyline[i].x;
+			if (x + vSize.x > vPageSize.x) break;
 
-			std::string sFileName(nFilePathSize, ' ');
-			for (uint32_t j = 0; j < nFilePathSize; j++)
-				sFileName[j] = get();
+			// The slot rests on the highest segment beneath it
+			int32_t y = 0;
+			for (size_t j = i; j < page.vSkyline.size() && page.vSkyline[j].x < x + vSize.x; j++)
+				y = std::max(y, page.vSkyline[j].y);
 
-			sResourceFile e;
-			read((char*)&e.nSize, sizeof(uint32_t));
-			read((char*)&e.nOffset, sizeof(uint32_t));
-			mapFiles[sFileName] = e;
+			if (y + vSize.y <= vPageSize.y && y + vSize.y < nBestY)
+			{
+				nBestY = y + vSize.y;
+				vPos = { x, y };
+				nNode = i;
+			}
 		}
-
-		// Don't close base file! we will provide a stream
-		// pointer when the file is requested
-		return true;
+		return nBestY != INT32_MAX;
 	}
 
-	bool ResourcePack::SavePack(const std::string& sFile, const std::string& sKey)
+	void Atlas::Occupy(Page& page, size_t nNode, const olc::vi2d& vPos, const olc::vi2d& vSize)
 	{
-		// Create/Overwrite the resource file
-		std::ofstream ofs(sFile, std::ofstream::binary);
-		if (!ofs.is_open()) return false;
+		auto& sky = page.vSkyline;
+		sky.insert(sky.begin() + nNode, { vPos.x, vPos.y + vSize.y, vSize.x });
 
-		// Iterate through map
-		uint32_t nIndexSize = 0; // Unknown for now
-		ofs.write((char*)&nIndexSize, sizeof(uint32_t));
-		uint32_t nMapSize = uint32_t(mapFiles.size());
-		ofs.write((char*)&nMapSize, sizeof(uint32_t));
-		for (auto& e : mapFiles)
+		// Trim the segments now underneath the slot
+		const int32_t nRight = vPos.x + vSize.x;
+		size_t i = nNode + 1;
+		while (i < sky.size() && sky[i].x < nRight)
 		{
-			// Write the path of the file
-			size_t nPathSize = e.first.size();
-			ofs.write((char*)&nPathSize, sizeof(uint32_t));
-			ofs.write(e.first.c_str(), nPathSize);
-
-			// Write the file entry properties
-			ofs.write((char*)&e.second.nSize, sizeof(uint32_t));
-			ofs.write((char*)&e.second.nOffset, sizeof(uint32_t));
+			const int32_t nShrink = nRight - sky[i].x;
+			if (nShrink >= sky[i].w)
+				sky.erase(sky.begin() + i);
+			else
+			{
+				sky[i].x += nShrink;
+				sky[i].w -= nShrink;
+				break;
+			}
 		}
 
-		// 2) Write the individual Data
-		std::streampos offset = ofs.tellp();
-		nIndexSize = (uint32_t)offset;
-		for (auto& e : mapFiles)
+		// Join neighbouring segments at the same height
+		for (i = 0; i + 1 < sky.size();)
 		{
-			// Store beginning of file offset within resource pack file
-			e.second.nOffset = (uint32_t)offset;
+			if (sky[i].y == sky[i + 1].y)
+			{
+				sky[i].w += sky[i + 1].w;
+				sky.erase(sky.begin() + i + 1);
+			}
+			else i++;
+		}
+	}
 
-			// Load the file to be added
-			std::vector<uint8_t> vBuffer(e.second.nSize);
-			std::ifstream i(e.first, std::ifstream::binary);
-			i.read((char*)vBuffer.data(), e.second.nSize);
-			i.close();
+	// O------------------------------------------------------------------------------O
+	// | olc::FrameWriter IMPLEMENTATION                                              |
+	// O------------------------------------------------------------------------------O
+	FrameWriter::~FrameWriter()
+	{ Close(); }
 
-			// Write the loaded file into resource pack file
-			ofs.write((char*)vBuffer.data(), e.second.nSize);
-			offset += e.second.nSize;
-		}
+	olc::rcode FrameWriter::Open(const std::string& sFile, Format format, uint32_t nFPS)
+	{
+		Close();
+		std::FILE* file = std::fopen(sFile.c_str(), "wb");
+		if (file == nullptr) return olc::rcode::NO_FILE;
+		Open(file, format, nFPS);
+		bOwnsFile = true;
+		return olc::rcode::OK;
+	}
 
-		// 3) Scramble Index
-		std::vector<char> stream;
-		auto write = [&stream](const char* data, size_t size) {
-			size_t sizeNow = stream.size();
-			stream.resize(sizeNow + size);
-			memcpy(stream.data() + sizeNow, data, size);
-		};
+	olc::rcode FrameWriter::Open(std::FILE* file, Format format, uint32_t nFPS)
+	{
+		Close();
+		if (file == nullptr) return olc::rcode::FAIL;
+		pFile = file;
+		bOwnsFile = false;
+		nFormat = format;
+		this->nFPS = std::max(nFPS, 1u);
+		vSize = { 0, 0 };
+		nQueued = 0; nNextFill = 0; nNextWrite = 0;
+		bStop = false;
+		bFailed = false;
+		nFramesWritten = 0;
+		thWriter = std::thread(&FrameWriter::Writer, this);
+		return olc::rcode::OK;
+	}
 
-		// Iterate through map
-		write((char*)&nMapSize, sizeof(uint32_t));
-		for (auto& e : mapFiles)
+	void FrameWriter::Close()
+	{
+		if (pFile == nullptr) return;
+		{
+			std::unique_lock<std::mutex> lock(muxQueue);
+			bStop = true;
+		}
+		cvQueued.notify_one();
+		thWriter.join();
+
+		if (bOwnsFile)
+			std::fclose(pFile);
+		else
+			std::fflush(pFile);
+		pFile = nullptr;
+		bOwnsFile = false;
+	}
+
+	bool FrameWriter::IsOpen() const
+	{ return pFile != nullptr; }
+
+	uint64_t FrameWriter::GetFramesWritten() const
+	{ return nFramesWritten; }
+
+	bool FrameWriter::Submit(const olc::Sprite& frame)
+	{
+		if (pFile == nullptr || bFailed || frame.width <= 0 || frame.height <= 0) return false;
+		if (vSize.x == 0) vSize = { frame.width, frame.height };
+		if (vSize != olc::vi2d(frame.width, frame.height)) return false;
+
+		// Only the writer thread touches queued buffers, so the free one
+		// can be filled without holding the lock
+		size_t nBuffer;
+		{
+			std::unique_lock<std::mutex> lock(muxQueue);
+			cvFree.wait(lock, [&] { return nQueued < vBuffers.size() || bFailed; });
+			if (bFailed) return false;
+			nBuffer = nNextFill;
+		}
+
+		vBuffers[nBuffer].assign(frame.pColData.begin(), frame.pColData.end());
+
+		{
+			std::unique_lock<std::mutex> lock(muxQueue);
+			nNextFill = (nNextFill + 1) % vBuffers.size();
+			nQueued++;
+		}
+		cvQueued.notify_one();
+		return true;
+	}
+
+	void FrameWriter::Writer()
+	{
+		bool bHeader = nFormat != Format::Y4M;
+		while (true)
+		{
+			size_t nBuffer;
+			{
+				std::unique_lock<std::mutex> lock(muxQueue);
+				cvQueued.wait(lock, [&] { return nQueued > 0 || bStop; });
+				if (nQueued == 0) return;
+				nBuffer = nNextWrite;
+			}
+
+			if (!bFailed)
+			{
+				if (!bHeader)
+				{
+					// The size is fixed by the first frame, which is now queued
+					const std::string sHeader = "YUV4MPEG2 W" + std::to_string(vSize.x) + " H" + std::to_string(vSize.y)
+						+ " F" + std::to_string(nFPS) + ":1 Ip A1:1 C444\n";
+					bFailed = std::fwrite(sHeader.data(), 1, sHeader.size(), pFile) != sHeader.size();
+					bHeader = true;
+				}
+				if (!bFailed) bFailed = !WriteFrame(vBuffers[nBuffer]);
+				if (!bFailed) nFramesWritten++;
+			}
+
+			{
+				std::unique_lock<std::mutex> lock(muxQueue);
+				nNextWrite = (nNextWrite + 1) % vBuffers.size();
+				nQueued--;
+			}
+			cvFree.notify_one();
+		}
+	}
+
+	bool FrameWriter::WriteFrame(const std::vector<olc::Pixel>& vFrame)
+	{
+		const size_t nPixels = vFrame.size();
+		if (nFormat == Format::RGBA)
+			return std::fwrite(vFrame.data(), sizeof(olc::Pixel), nPixels, pFile) == nPixels;
+
+		// Full resolution Y, U then V planes. The offsets keep intermediate
+		// values positive so the shifts round the same on every compiler
+		vPlanes.resize(nPixels * 3);
+		uint8_t* pY = vPlanes.data();
+		uint8_t* pU = pY + nPixels;
+		uint8_t* pV = pU + nPixels;
+		for (size_t i = 0; i < nPixels; i++)
+		{
+			const int32_t r = vFrame[i].r, g = vFrame[i].g, b = vFrame[i].b;
+			pY[i] = uint8_t(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+			pU[i] = uint8_t((-38 * r - 74 * g + 112 * b + 32896) >> 8);
+			pV[i] = uint8_t((112 * r - 94 * g - 18 * b + 32896) >> 8);
+		}
+
+		static const char sFrame[] = "FRAME\n";
+		return std::fwrite(sFrame, 1, sizeof(sFrame) - 1, pFile) == sizeof(sFrame) - 1
+			&& std::fwrite(vPlanes.data(), 1, vPlanes.size(), pFile) == vPlanes.size();
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | olc::Profiler IMPLEMENTATION                                                 |
+	// O------------------------------------------------------------------------------O
+	std::atomic<bool> Profiler::bEnabled{ false };
+	std::mutex Profiler::muxRings;
+	std::vector<std::unique_ptr<Profiler::Ring>> Profiler::vRings;
+
+	void Profiler::Slot::Store(const Zone& z)
+	{
+		sName.store(z.sName, std::memory_order_relaxed);
+		nStart.store(z.nStart, std::memory_order_relaxed);
+		nEnd.store(z.nEnd, std::memory_order_relaxed);
+	}
+
+	Profiler::Zone Profiler::Slot::Load() const
+	{ return { sName.load(std::memory_order_relaxed), nStart.load(std::memory_order_relaxed), nEnd.load(std::memory_order_relaxed) }; }
+
+	void Profiler::Enable(const bool bEnable)
+	{ bEnabled = bEnable; }
+
+	int64_t Profiler::Now()
+	{ return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+	std::string& Profiler::ThisThreadName()
+	{
+		thread_local std::string sName;
+		return sName;
+	}
+
+	Profiler::Ring*& Profiler::ThisThreadRing()
+	{
+		thread_local Ring* pRing = nullptr;
+		return pRing;
+	}
+
+	Profiler::Ring* Profiler::ThisThread()
+	{
+		Ring*& pRing = ThisThreadRing();
+		if (pRing == nullptr)
+		{
+			std::unique_lock<std::mutex> lock(muxRings);
+			vRings.push_back(std::make_unique<Ring>());
+			pRing = vRings.back().get();
+			pRing->nThread = uint32_t(vRings.size());
+			pRing->sName = ThisThreadName();
+		}
+		return pRing;
+	}
+
+	void Profiler::Record(const char* sName, const int64_t nStart, const int64_t nEnd)
+	{
+		// Only this thread writes its ring, readers check nWritten to spot
+		// zones overwritten while they looked
+		Ring* r = ThisThread();
+		const uint64_t n = r->nWritten.load(std::memory_order_relaxed);
+		r->vZones[n % nRingSize].Store({ sName, nStart, nEnd });
+		r->nWritten.store(n + 1, std::memory_order_release);
+	}
+
+	void Profiler::SetThreadName(const std::string& sName)
+	{
+		ThisThreadName() = sName;
+		if (Ring* r = ThisThreadRing())
+		{
+			std::unique_lock<std::mutex> lock(muxRings);
+			r->sName = sName;
+		}
+	}
+
+	void Profiler::GetZones(const int64_t nSince, std::vector<Zone>& vZones)
+	{
+		std::unique_lock<std::mutex> lock(muxRings);
+		for (auto& r : vRings)
+		{
+			// A thread's zones are recorded in the order they end
+			const size_t nFirst = vZones.size();
+			const uint64_t nWritten = r->nWritten.load(std::memory_order_acquire);
+			uint64_t i = nWritten;
+			for (; i > 0 && nWritten - i < nRingSize; i--)
+			{
+				const Zone z = r->vZones[(i - 1) % nRingSize].Load();
+				if (z.nEnd < nSince) break;
+				vZones.push_back(z);
+			}
+
+			// Drop any the thread lapped while they were copied
+			const uint64_t nNow = r->nWritten.load(std::memory_order_acquire);
+			const uint64_t nLapped = nNow > nRingSize ? nNow - nRingSize : 0;
+			for (size_t k = nFirst; k < vZones.size(); k++)
+			{
+				if (nWritten - 1 - (k - nFirst) < nLapped)
+				{
+					vZones.resize(k);
+					break;
+				}
+			}
+		}
+	}
+
+	olc::rcode Profiler::SaveTrace(const std::string& sFile)
+	{
+		std::ofstream ofs(sFile, std::ofstream::out | std::ofstream::trunc);
+		if (!ofs.is_open()) return olc::rcode::FAIL;
+
+		auto Escaped = [](const char* s)
+		{
+			std::string out;
+			for (; *s; s++)
+			{
+				if (*s == '"' || *s == '\\') out += '\\';
+				if (uint8_t(*s) >= 0x20) out += *s;
+			}
+			return out;
+		};
+
+		std::unique_lock<std::mutex> lock(muxRings);
+		std::vector<std::pair<uint32_t, Zone>> vAll;
+		int64_t nOrigin = INT64_MAX;
+		for (auto& r : vRings)
+		{
+			std::vector<Zone> vZones;
+			const uint64_t nWritten = r->nWritten.load(std::memory_order_acquire);
+			const uint64_t nFirst = nWritten > nRingSize ? nWritten - nRingSize : 0;
+			for (uint64_t i = nFirst; i < nWritten; i++)
+				vZones.push_back(r->vZones[i % nRingSize].Load());
+			const uint64_t nNow = r->nWritten.load(std::memory_order_acquire);
+			const uint64_t nLapped = nNow > nRingSize ? nNow - nRingSize : 0;
+			for (uint64_t i = std::max(nFirst, nLapped); i < nWritten; i++)
+			{
+				const Zone& z = vZones[size_t(i - nFirst)];
+				nOrigin = std::min(nOrigin, z.nStart);
+				vAll.push_back({ r->nThread, z });
+			}
+		}
+
+		// Microseconds from the earliest zone held, as the format expects
+		char sLine[512];
+		ofs << "{\"traceEvents\":[\n";
+		bool bFirst = true;
+		for (auto& e : vAll)
+		{
+			std::snprintf(sLine, sizeof(sLine), "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				bFirst ? "" : ",\n", Escaped(e.second.sName).c_str(), e.first,
+				double(e.second.nStart - nOrigin) / 1000.0, double(e.second.nEnd - e.second.nStart) / 1000.0);
+			ofs << sLine;
+			bFirst = false;
+		}
+		for (auto& r : vRings)
+		{
+			if (r->sName.empty()) continue;
+			std::snprintf(sLine, sizeof(sLine), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+				bFirst ? "" : ",\n", r->nThread, Escaped(r->sName.c_str()).c_str());
+			ofs << sLine;
+			bFirst = false;
+		}
+		ofs << "\n]}\n";
+		return ofs.good() ? olc::rcode::OK : olc::rcode::FAIL;
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | olc::ResourcePack IMPLEMENTATION                                             |
+	// O------------------------------------------------------------------------------O
+
+
+	//=============================================================
+	// Resource Packs - Allows you to store files in one large 
+	// scrambled file - Thanks MaGetzUb for debugging a null char in std::stringstream bug
+	ResourceBuffer::ResourceBuffer(std::ifstream& ifs, uint32_t offset, uint32_t size)
+	{
+		vMemory.resize(size);
+		ifs.seekg(offset); ifs.read(vMemory.data(), vMemory.size());
+		setg(vMemory.data(), vMemory.data(), vMemory.data() + size);
+	}
+
+	ResourcePack::ResourcePack() { }
+	ResourcePack::~ResourcePack() { baseFile.close(); }
+
+	bool ResourcePack::AddFile(const std::string& sFile)
+	{
+		const std::string file = makeposix(sFile);
+
+		if (_gfs::exists(file))
+		{
+			sResourceFile e;
+			e.nSize = (uint32_t)_gfs::file_size(file);
+			e.nOffset = 0; // Unknown at this stage			
+			mapFiles[file] = e;
+			return true;
+		}
+		return false;
+	}
+
+	bool ResourcePack::LoadPack(const std::string& sFile, const std::string& sKey)
+	{
+		// Open the resource file
+		baseFile.open(sFile, std::ifstream::binary);
+		if (!baseFile.is_open()) return false;
+
+		// 1) Read Scrambled index
+		uint32_t nIndexSize = 0;
+		baseFile.read((char*)&nIndexSize, sizeof(uint32_t));
+
+		std::vector<char> buffer(nIndexSize);
+		for (uint32_t j = 0; j < nIndexSize; j++)
+			buffer[j] = baseFile.get();
+
+		std::vector<char> decoded = scramble(buffer, sKey);
+		size_t pos = 0;
+		auto read = [&decoded, &pos](char* dst, size_t size) {
+			memcpy((void*)dst, (const void*)(decoded.data() + pos), size);
+			pos += size;
+		};
+
+		auto get = [&read]() -> int { char c; read(&c, 1); return c; };
+
+		// 2) Read Map
+		uint32_t nMapEntries = 0;
+		read((char*)&nMapEntries, sizeof(uint32_t));
+		for (uint32_t i = 0; i < nMapEntries; i++)
+		{
+			uint32_t nFilePathSize = 0;
+			read((char*)&nFilePathSize, sizeof(uint32_t));
+
+			std::string sFileName(nFilePathSize, ' ');
+			for (uint32_t j = 0; j < nFilePathSize; j++)
+				sFileName[j] = get();
+
+			sResourceFile e;
+			read((char*)&e.nSize, sizeof(uint32_t));
+			read((char*)&e.nOffset, sizeof(uint32_t));
+			mapFiles[sFileName] = e;
+		}
+
+		// Don't close base file! we will provide a stream
+		// pointer when the file is requested
+		return true;
+	}
+
+	bool ResourcePack::SavePack(const std::string& sFile, const std::string& sKey)
+	{
+		// Create/Overwrite the resource file
+		std::ofstream ofs(sFile, std::ofstream::binary);
+		if (!ofs.is_open()) return false;
+
+		// Iterate through map
+		uint32_t nIndexSize = 0; // Unknown for now
+		ofs.write((char*)&nIndexSize, sizeof(uint32_t));
+		uint32_t nMapSize = uint32_t(mapFiles.size());
+		ofs.write((char*)&nMapSize, sizeof(uint32_t));
+		for (auto& e : mapFiles)
+		{
+			// Write the path of the file
+			size_t nPathSize = e.first.size();
+			ofs.write((char*)&nPathSize, sizeof(uint32_t));
+			ofs.write(e.first.c_str(), nPathSize);
+
+			// Write the file entry properties
+			ofs.write((char*)&e.second.nSize, sizeof(uint32_t));
+			ofs.write((char*)&e.second.nOffset, sizeof(uint32_t));
+		}
+
+		// 2) Write the individual Data
+		std::streampos offset = ofs.tellp();
+		nIndexSize = (uint32_t)offset;
+		for (auto& e : mapFiles)
+		{
+			// Store beginning of file offset within resource pack file
+			e.second.nOffset = (uint32_t)offset;
+
+			// Load the file to be added
+			std::vector<uint8_t> vBuffer(e.second.nSize);
+			std::ifstream i(e.first, std::ifstream::binary);
+			i.read((char*)vBuffer.data(), e.second.nSize);
+			i.close();
+
+			// Write the loaded file into resource pack file
+			ofs.write((char*)vBuffer.data(), e.second.nSize);
+			offset += e.second.nSize;
+		}
+
+		// 3) Scramble Index
+		std::vector<char> stream;
+		auto write = [&stream](const char* data, size_t size) {
+			size_t sizeNow = stream.size();
+			stream.resize(sizeNow + size);
+			memcpy(stream.data() + sizeNow, data, size);
+		};
+
+		// Iterate through map
+		write((char*)&nMapSize, sizeof(uint32_t));
+		for (auto& e : mapFiles)
+		{
+			// Write the path of the file
+			size_t nPathSize = e.first.size();
+			write((char*)&nPathSize, sizeof(uint32_t));
+			write(e.first.c_str(), nPathSize);
+
+			// Write the file entry properties
+			write((char*)&e.second.nSize, sizeof(uint32_t));
+			write((char*)&e.second.nOffset, sizeof(uint32_t));
+		}
+		std::vector<char> sIndexString = scramble(stream, sKey);
+		uint32_t nIndexStringLen = uint32_t(sIndexString.size());
+		// 4) Rewrite Map (it has been updated with offsets now)
+		// at start of file
+		ofs.seekp(0, std::ios::beg);
+		ofs.write((char*)&nIndexStringLen, sizeof(uint32_t));
+		ofs.write(sIndexString.data(), nIndexStringLen);
+		ofs.close();
+		return true;
+	}
+
+	ResourceBuffer ResourcePack::GetFileBuffer(const std::string& sFile)
+	{ return ResourceBuffer(baseFile, mapFiles[sFile].nOffset, mapFiles[sFile].nSize); }
+
+	bool ResourcePack::Loaded()
+	{ return baseFile.is_open(); }
+
+	std::vector<char> ResourcePack::scramble(const std::vector<char>& data, const std::string& key)
+	{
+		if (key.empty()) return data;
+		std::vector<char> o;
+		size_t c = 0;
+		for (auto s : data)	o.push_back(s ^ key[(c++) % key.size()]);
+		return o;
+	};
+
+	std::string ResourcePack::makeposix(const std::string& path)
+	{
+		std::string o;
+		for (auto s : path) o += std::string(1, s == '\\' ? '/' : s);
+		return o;
+	};
+
+	// O------------------------------------------------------------------------------O
+	// | Alpha Blending Kernels                                                       |
+	// O------------------------------------------------------------------------------O
+	// Integer "source over destination" blend used by Pixel::ALPHA. The effective
+	// alpha is the source alpha scaled by the blend factor (0-256 fixed point). Colour
+	// channels lerp towards the source, and the source alpha channel is treated as
+	// 255 so destination alpha accumulates rather than being thrown away. The scalar
+	// and vector paths use identical arithmetic, so results never depend on the CPU.
+	namespace blend
+	{
+		inline uint32_t BlendFactor(const float fBlend)
+		{ return uint32_t(fBlend * 256.0f); }
+
+		// Rounded division by 255 of t, where t is the blend sum + 128
+		inline uint32_t Div255(const uint32_t t)
+		{ return (t + (t >> 8)) >> 8; }
+
+		inline Pixel Blend(const Pixel s, const Pixel d, const uint32_t nBlend)
+		{
+			uint32_t a = (uint32_t(s.a) * nBlend) >> 8;
+			uint32_t c = 255 - a;
+			return Pixel(
+				uint8_t(Div255(s.r * a + d.r * c + 128)),
+				uint8_t(Div255(s.g * a + d.g * c + 128)),
+				uint8_t(Div255(s.b * a + d.b * c + 128)),
+				uint8_t(Div255(255 * a + d.a * c + 128)));
+		}
+
+#if defined(OLC_SIMD_SSE2)
+		// Lerps eight 16-bit channels (two pixels) given the pre-multiplied source
+		// term (s * a + 128) and the inverse alpha (255 - a)
+		inline __m128i Lerp_SSE2(const __m128i sa, const __m128i d, const __m128i inv)
+		{
+			__m128i t = _mm_add_epi16(sa, _mm_mullo_epi16(d, inv));
+			return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+		}
+
+		inline __m128i Blend4_SSE2(__m128i s, const __m128i d, const __m128i vBlend)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i v255 = _mm_set1_epi16(255);
+			const __m128i v128 = _mm_set1_epi16(128);
+
+			// Scaled alpha of each pixel, copied into every 16-bit channel lane
+			__m128i a = _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi32(s, 24), vBlend), 8);
+			a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+			const __m128i alo = _mm_unpacklo_epi32(a, a);
+			const __m128i ahi = _mm_unpackhi_epi32(a, a);
+
+			s = _mm_or_si128(s, _mm_set1_epi32(int32_t(0xFF000000)));
+			const __m128i slo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), alo), v128);
+			const __m128i shi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), ahi), v128);
+			return _mm_packus_epi16(
+				Lerp_SSE2(slo, _mm_unpacklo_epi8(d, zero), _mm_sub_epi16(v255, alo)),
+				Lerp_SSE2(shi, _mm_unpackhi_epi8(d, zero), _mm_sub_epi16(v255, ahi)));
+		}
+#endif
+
+#if defined(OLC_SIMD_AVX2)
+		inline __m256i Lerp_AVX2(const __m256i sa, const __m256i d, const __m256i inv)
+		{
+			__m256i t = _mm256_add_epi16(sa, _mm256_mullo_epi16(d, inv));
+			return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+		}
+
+		// Unpack and pack both work within 128-bit lanes, so pixel order survives
+		inline __m256i Blend8_AVX2(__m256i s, const __m256i d, const __m256i vBlend)
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i v255 = _mm256_set1_epi16(255);
+			const __m256i v128 = _mm256_set1_epi16(128);
+
+			__m256i a = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_srli_epi32(s, 24), vBlend), 8);
+			a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+			const __m256i alo = _mm256_unpacklo_epi32(a, a);
+			const __m256i ahi = _mm256_unpackhi_epi32(a, a);
+
+			s = _mm256_or_si256(s, _mm256_set1_epi32(int32_t(0xFF000000)));
+			const __m256i slo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zero), alo), v128);
+			const __m256i shi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zero), ahi), v128);
+			return _mm256_packus_epi16(
+				Lerp_AVX2(slo, _mm256_unpacklo_epi8(d, zero), _mm256_sub_epi16(v255, alo)),
+				Lerp_AVX2(shi, _mm256_unpackhi_epi8(d, zero), _mm256_sub_epi16(v255, ahi)));
+		}
+#endif
+
+		// Blends n source pixels over n destination pixels
+		void BlendRow(Pixel* pDst, const Pixel* pSrc, size_t n, const uint32_t nBlend)
+		{
+			size_t i = 0;
+#if defined(OLC_SIMD_AVX2)
+			const __m256i vBlend8 = _mm256_set1_epi16(int16_t(nBlend));
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256i s = _mm256_loadu_si256((const __m256i*)(pSrc + i));
+				__m256i d = _mm256_loadu_si256((const __m256i*)(pDst + i));
+				_mm256_storeu_si256((__m256i*)(pDst + i), Blend8_AVX2(s, d, vBlend8));
+			}
+#endif
+#if defined(OLC_SIMD_SSE2)
+			const __m128i vBlend4 = _mm_set1_epi16(int16_t(nBlend));
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128i s = _mm_loadu_si128((const __m128i*)(pSrc + i));
+				__m128i d = _mm_loadu_si128((const __m128i*)(pDst + i));
+				_mm_storeu_si128((__m128i*)(pDst + i), Blend4_SSE2(s, d, vBlend4));
+			}
+#endif
+			for (; i < n; i++)
+				pDst[i] = Blend(pSrc[i], pDst[i], nBlend);
+		}
+
+		// Blends a single colour over n destination pixels, the source terms
+		// are constant so they are only calculated once
+		void BlendFill(Pixel* pDst, const Pixel src, size_t n, const uint32_t nBlend)
+		{
+			size_t i = 0;
+#if defined(OLC_SIMD_AVX2) || defined(OLC_SIMD_SSE2)
+			const uint32_t a = (uint32_t(src.a) * nBlend) >> 8;
+			const Pixel s = Pixel(src.r, src.g, src.b, 255);
+#endif
+#if defined(OLC_SIMD_AVX2)
+			{
+				const __m256i zero = _mm256_setzero_si256();
+				const __m256i sa = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(_mm256_set1_epi32(int32_t(s.n)), zero), _mm256_set1_epi16(int16_t(a))), _mm256_set1_epi16(128));
+				const __m256i inv = _mm256_set1_epi16(int16_t(255 - a));
+				for (; i + 8 <= n; i += 8)
+				{
+					__m256i d = _mm256_loadu_si256((const __m256i*)(pDst + i));
+					_mm256_storeu_si256((__m256i*)(pDst + i), _mm256_packus_epi16(
+						Lerp_AVX2(sa, _mm256_unpacklo_epi8(d, zero), inv),
+						Lerp_AVX2(sa, _mm256_unpackhi_epi8(d, zero), inv)));
+				}
+			}
+#endif
+#if defined(OLC_SIMD_SSE2)
+			{
+				const __m128i zero = _mm_setzero_si128();
+				const __m128i sa = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32(int32_t(s.n)), zero), _mm_set1_epi16(int16_t(a))), _mm_set1_epi16(128));
+				const __m128i inv = _mm_set1_epi16(int16_t(255 - a));
+				for (; i + 4 <= n; i += 4)
+				{
+					__m128i d = _mm_loadu_si128((const __m128i*)(pDst + i));
+					_mm_storeu_si128((__m128i*)(pDst + i), _mm_packus_epi16(
+						Lerp_SSE2(sa, _mm_unpacklo_epi8(d, zero), inv),
+						Lerp_SSE2(sa, _mm_unpackhi_epi8(d, zero), inv)));
+				}
+			}
+#endif
+			for (; i < n; i++)
+				pDst[i] = Blend(src, pDst[i], nBlend);
+		}
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | Pixel Mode Policies                                                          |
+	// O------------------------------------------------------------------------------O
+	// Each Pixel::Mode as a type, the span writers are templated on these so the
+	// mode is resolved once per primitive rather than once per pixel. Fill() writes
+	// a single colour, Copy() a source row, both to n pixels starting at (x,y)
+	namespace pixelmode
+	{
+		struct Normal
+		{
+			static constexpr Pixel::Mode nMode = Pixel::NORMAL;
+			void Fill(int32_t, int32_t, Pixel* pDst, int32_t n, const Pixel p) const
+			{ std::fill_n(pDst, n, p); }
+
+			// Rows overlap when a sprite is drawn onto itself
+			void Copy(int32_t, int32_t, Pixel* pDst, const Pixel* pSrc, int32_t n) const
+			{ std::memmove(pDst, pSrc, size_t(n) * sizeof(Pixel)); }
+		};
+
+		struct Mask
+		{
+			static constexpr Pixel::Mode nMode = Pixel::MASK;
+			void Fill(int32_t, int32_t, Pixel* pDst, int32_t n, const Pixel p) const
+			{ if (p.a == 255) std::fill_n(pDst, n, p); }
+
+			void Copy(int32_t, int32_t, Pixel* pDst, const Pixel* pSrc, int32_t n) const
+			{
+				for (int32_t i = 0; i < n; i++)
+					if (pSrc[i].a == 255) pDst[i] = pSrc[i];
+			}
+		};
+
+		struct Alpha
 		{
-			// Write the path of the file
-			size_t nPathSize = e.first.size();
-			write((char*)&nPathSize, sizeof(uint32_t));
-			write(e.first.c_str(), nPathSize);
+			static constexpr Pixel::Mode nMode = Pixel::ALPHA;
+			uint32_t nBlend;
 
-			// Write the file entry properties
-			write((char*)&e.second.nSize, sizeof(uint32_t));
-			write((char*)&e.second.nOffset, sizeof(uint32_t));
+			void Fill(int32_t, int32_t, Pixel* pDst, int32_t n, const Pixel p) const
+			{ blend::BlendFill(pDst, p, size_t(n), nBlend); }
+
+			void Copy(int32_t, int32_t, Pixel* pDst, const Pixel* pSrc, int32_t n) const
+			{ blend::BlendRow(pDst, pSrc, size_t(n), nBlend); }
+		};
+
+		// Prefers the span function if one is set, else falls back to per pixel
+		struct Custom
+		{
+			static constexpr Pixel::Mode nMode = Pixel::CUSTOM;
+			const std::function<olc::Pixel(const int x, const int y, const olc::Pixel&, const olc::Pixel&)>& funcPixel;
+			const std::function<void(const int x, const int y, const int32_t count, const olc::Pixel*, olc::Pixel*)>& funcSpan;
+			std::vector<olc::Pixel>& vFill;
+
+			void Fill(int32_t x, int32_t y, Pixel* pDst, int32_t n, const Pixel p) const
+			{
+				if (funcSpan)
+				{
+					vFill.assign(size_t(n), p);
+					funcSpan(x, y, n, vFill.data(), pDst);
+				}
+				else
+					for (int32_t i = 0; i < n; i++)
+						pDst[i] = funcPixel(x + i, y, p, pDst[i]);
+			}
+
+			void Copy(int32_t x, int32_t y, Pixel* pDst, const Pixel* pSrc, int32_t n) const
+			{
+				if (funcSpan)
+					funcSpan(x, y, n, pSrc, pDst);
+				else
+					for (int32_t i = 0; i < n; i++)
+						pDst[i] = funcPixel(x + i, y, pSrc[i], pDst[i]);
+			}
+		};
+
+		// Pixels a span writes, MASK skips the ones that are not opaque
+		template<typename Mode>
+		uint64_t Written(int32_t n, const Pixel p, const Pixel* pSrc)
+		{
+			if constexpr (std::is_same_v<Mode, Mask>)
+			{
+				if (pSrc == nullptr) return p.a == 255 ? uint64_t(n) : 0;
+				return uint64_t(std::count_if(pSrc, pSrc + n, [](const Pixel& s) { return s.a == 255; }));
+			}
+			return uint64_t(n);
 		}
-		std::vector<char> sIndexString = scramble(stream, sKey);
-		uint32_t nIndexStringLen = uint32_t(sIndexString.size());
-		// 4) Rewrite Map (it has been updated with offsets now)
-		// at start of file
-		ofs.seekp(0, std::ios::beg);
-		ofs.write((char*)&nIndexStringLen, sizeof(uint32_t));
-		ofs.write(sIndexString.data(), nIndexStringLen);
-		ofs.close();
-		return true;
 	}
 
-	ResourceBuffer ResourcePack::GetFileBuffer(const std::string& sFile)
-	{ return ResourceBuffer(baseFile, mapFiles[sFile].nOffset, mapFiles[sFile].nSize); }
+	// O------------------------------------------------------------------------------O
+	// | Triangle Rasterisation                                                       |
+	// O------------------------------------------------------------------------------O
+	// Edge functions evaluated in 64-bit fixed point, so no overflow regardless of
+	// how far off screen vertices are. Rows of up to 8 pixels are tested at once,
+	// the sign bits of the three edge values OR'd together give the outside mask
+	namespace raster
+	{
+		constexpr int32_t nSubBits = 4;
+		constexpr int64_t nSubOne = int64_t(1) << nSubBits;
+		constexpr int32_t nBlock = 8;
 
-	bool ResourcePack::Loaded()
-	{ return baseFile.is_open(); }
+		// E(x,y) = C + A * x + B * y for pixel (x,y), inside when E >= 0
+		struct Edge
+		{
+			int64_t A = 0, B = 0, C = 0;
+			alignas(32) int64_t vStep[nBlock];
 
-	std::vector<char> ResourcePack::scramble(const std::vector<char>& data, const std::string& key)
-	{
-		if (key.empty()) return data;
-		std::vector<char> o;
-		size_t c = 0;
-		for (auto s : data)	o.push_back(s ^ key[(c++) % key.size()]);
-		return o;
-	};
+			void Setup(const int64_t x0, const int64_t y0, const int64_t x1, const int64_t y1)
+			{
+				A = (y0 - y1) * nSubOne;
+				B = (x1 - x0) * nSubOne;
+				C = (y1 - y0) * x0 - (x1 - x0) * y0;
 
-	std::string ResourcePack::makeposix(const std::string& path)
-	{
-		std::string o;
-		for (auto s : path) o += std::string(1, s == '\\' ? '/' : s);
-		return o;
-	};
+				// Top-left rule, pixels exactly on a right or bottom edge belong to
+				// the neighbouring triangle, so shared edges are drawn once
+				const bool bTopLeft = (y1 < y0) || (y1 == y0 && x1 > x0);
+				if (!bTopLeft) C -= 1;
+
+				for (int32_t i = 0; i < nBlock; i++)
+					vStep[i] = A * i;
+			}
+
+			int64_t At(const int32_t x, const int32_t y) const
+			{ return C + A * x + B * y; }
+		};
+
+		// Bit i is set if pixel i of the n (<= 8) pixel run is inside all edges,
+		// E holds the edge values at the first pixel
+		inline uint32_t RowMask(const Edge* e, const int64_t* E, const int32_t n)
+		{
+			uint32_t nOutside = 0;
+#if defined(OLC_SIMD_AVX2)
+			const __m256i e0 = _mm256_set1_epi64x(E[0]), e1 = _mm256_set1_epi64x(E[1]), e2 = _mm256_set1_epi64x(E[2]);
+			for (int32_t i = 0; i < nBlock; i += 4)
+			{
+				__m256i v = _mm256_or_si256(_mm256_or_si256(
+					_mm256_add_epi64(e0, _mm256_load_si256((const __m256i*)(e[0].vStep + i))),
+					_mm256_add_epi64(e1, _mm256_load_si256((const __m256i*)(e[1].vStep + i)))),
+					_mm256_add_epi64(e2, _mm256_load_si256((const __m256i*)(e[2].vStep + i))));
+				nOutside |= uint32_t(_mm256_movemask_pd(_mm256_castsi256_pd(v))) << i;
+			}
+#elif defined(OLC_SIMD_SSE2)
+			const __m128i e0 = _mm_set1_epi64x(E[0]), e1 = _mm_set1_epi64x(E[1]), e2 = _mm_set1_epi64x(E[2]);
+			for (int32_t i = 0; i < nBlock; i += 2)
+			{
+				__m128i v = _mm_or_si128(_mm_or_si128(
+					_mm_add_epi64(e0, _mm_load_si128((const __m128i*)(e[0].vStep + i))),
+					_mm_add_epi64(e1, _mm_load_si128((const __m128i*)(e[1].vStep + i)))),
+					_mm_add_epi64(e2, _mm_load_si128((const __m128i*)(e[2].vStep + i))));
+				nOutside |= uint32_t(_mm_movemask_pd(_mm_castsi128_pd(v))) << i;
+			}
+#else
+			for (int32_t i = 0; i < nBlock; i++)
+				if (((E[0] + e[0].vStep[i]) | (E[1] + e[1].vStep[i]) | (E[2] + e[2].vStep[i])) < 0)
+					nOutside |= 1u << i;
+#endif
+			return ~nOutside & ((1u << n) - 1);
+		}
+
+		inline int64_t FloorDiv(const int64_t v) { return v >> nSubBits; }
+		inline int64_t CeilDiv(const int64_t v) { return -((-v) >> nSubBits); }
+
+		// Vertices further than this many pixels from the origin could overflow the
+		// edge functions once snapped
+		constexpr double fGuardBand = double(1 << 24);
+
+		// Snaps a triangle to fixed point and calls fnSnapped(x, y) with its three
+		// vertices. Triangles reaching past the guard band are clipped to it first
+		// and handed over as a fan, those with NaN or infinite vertices are dropped
+		template<typename F>
+		void SnapTriangle(const double* vx, const double* vy, F&& fnSnapped)
+		{
+			for (int i = 0; i < 3; i++)
+				if (!std::isfinite(vx[i]) || !std::isfinite(vy[i])) return;
+
+			auto Snap = [](const double v) { return int64_t(std::llround(v * double(nSubOne))); };
+			if (std::max({ std::abs(vx[0]), std::abs(vx[1]), std::abs(vx[2]), std::abs(vy[0]), std::abs(vy[1]), std::abs(vy[2]) }) <= fGuardBand)
+			{
+				const int64_t x[3] = { Snap(vx[0]), Snap(vx[1]), Snap(vx[2]) };
+				const int64_t y[3] = { Snap(vy[0]), Snap(vy[1]), Snap(vy[2]) };
+				return fnSnapped(x, y);
+			}
+
+			// Each side of the band adds at most one vertex
+			double px[7] = { vx[0], vx[1], vx[2] }, py[7] = { vy[0], vy[1], vy[2] };
+			int n = 3;
+			for (int nSide = 0; nSide < 4 && n >= 3; nSide++)
+			{
+				// Distance inside this side, x <= G, x >= -G, y <= G or y >= -G
+				auto Inside = [&](const int i) { const double v = nSide < 2 ? px[i] : py[i]; return fGuardBand - ((nSide & 1) ? -v : v); };
+				double qx[7], qy[7];
+				int m = 0;
+				for (int i = 0; i < n; i++)
+				{
+					const int j = (i + 1) % n;
+					const double di = Inside(i), dj = Inside(j);
+					if (di >= 0.0) { qx[m] = px[i]; qy[m] = py[i]; m++; }
+					if ((di >= 0.0) != (dj >= 0.0))
+					{
+						// Step out from the inside vertex, the other may be too far off to
+						// interpolate from without losing everything to cancellation
+						const int a = di >= 0.0 ? i : j, b = di >= 0.0 ? j : i;
+						const double t = Inside(a) / (Inside(a) - Inside(b));
+						qx[m] = px[a] + (px[b] - px[a]) * t;
+						qy[m] = py[a] + (py[b] - py[a]) * t;
+						m++;
+					}
+				}
+				std::copy_n(qx, m, px);
+				std::copy_n(qy, m, py);
+				n = m;
+			}
+
+			for (int i = 1; i + 1 < n; i++)
+			{
+				const int64_t x[3] = { Snap(px[0]), Snap(px[i]), Snap(px[i + 1]) };
+				const int64_t y[3] = { Snap(py[0]), Snap(py[i]), Snap(py[i + 1]) };
+				fnSnapped(x, y);
+			}
+		}
+	}
 
 	// O------------------------------------------------------------------------------O
 	// | olc::PixelGameEngine IMPLEMENTATION                                          |
@@ -2247,7 +3788,11 @@ namespace olc
 	}
 
 	PixelGameEngine::~PixelGameEngine()
-	{}
+	{
+		DeferredStopWorkers();
+		// Decals that outlive the engine go straight to the renderer
+		if (Renderer::ptrPGE == this) Renderer::ptrPGE = nullptr;
+	}
 
 
 	olc::rcode PixelGameEngine::Construct(int32_t screen_w, int32_t screen_h, int32_t pixel_w, int32_t pixel_h, bool full_screen, bool vsync, bool cohesion, bool realwindow)
@@ -2278,14 +3823,17 @@ namespace olc
 			layer.bUpdate = true;
 		}
 		SetDrawTarget(nullptr);
-		if (!bRealWindowMode)
+		adv_RunOnRenderThread([&]
 		{
-			// Flush backbuffer
-			renderer->ClearBuffer(olc::BLACK, true);
-			renderer->DisplayFrame();
-			renderer->ClearBuffer(olc::BLACK, true);
-		}
-		renderer->UpdateViewport(vViewPos, vViewSize);
+			if (!bRealWindowMode)
+			{
+				// Flush backbuffer
+				renderer->ClearBuffer(olc::BLACK, true);
+				renderer->DisplayFrame();
+				renderer->ClearBuffer(olc::BLACK, true);
+			}
+			renderer->UpdateViewport(vViewPos, vViewSize);
+		});
 	}
 
 #if !defined(PGE_USE_CUSTOM_START)
@@ -2318,12 +3866,16 @@ namespace olc
 		if (target)
 		{
 			pDrawTarget = target;
+			bDrawTargetIsLayer = std::any_of(vLayers.begin(), vLayers.end(), [&](LayerDesc& layer) { return layer.pDrawTarget.Sprite() == target; });
 		}
 		else
 		{
 			nTargetLayer = 0;
-			if(!vLayers.empty())
+			if (!vLayers.empty())
+			{
 				pDrawTarget = vLayers[0].pDrawTarget.Sprite();
+				bDrawTargetIsLayer = true;
+			}
 		}
 	}
 
@@ -2332,6 +3884,7 @@ namespace olc
 		if (layer < vLayers.size())
 		{
 			pDrawTarget = vLayers[layer].pDrawTarget.Sprite();
+			bDrawTargetIsLayer = true;
 			vLayers[layer].bUpdate = bDirty;
 			nTargetLayer = layer;
 		}
@@ -2358,6 +3911,12 @@ namespace olc
 	void PixelGameEngine::SetLayerCustomRenderFunction(uint8_t layer, std::function<void()> f)
 	{ if (layer < vLayers.size()) vLayers[layer].funcHook = f; }
 
+	void PixelGameEngine::EnableLayerDecalSort(uint8_t layer, bool b)
+	{ if (layer < vLayers.size()) vLayers[layer].bSortDecals = b; }
+
+	void PixelGameEngine::SetAsyncTextureUploads(bool b)
+	{ adv_RunOnRenderThread([&] { renderer->SetAsyncUploads(b); }); }
+
 	std::vector<LayerDesc>& PixelGameEngine::GetLayers()
 	{ return vLayers; }
 
@@ -2391,6 +3950,18 @@ namespace olc
 	uint32_t PixelGameEngine::GetFPS() const
 	{ return nLastFPS; }
 
+	uint32_t PixelGameEngine::GetCulledDecalCount() const
+	{ return nLastDecalsCulled; }
+
+	const olc::FrameStats& PixelGameEngine::GetFrameStats() const
+	{ return statsLast; }
+
+	const olc::Sprite* PixelGameEngine::GetLastFrame() const
+	{ return renderer->GetFrame(); }
+
+	void PixelGameEngine::SetFrameWriter(olc::FrameWriter* writer)
+	{ pFrameWriter = writer; }
+
 	bool PixelGameEngine::IsFocused() const
 	{ return bHasInputFocus; }
 
@@ -2421,6 +3992,58 @@ namespace olc
 	float PixelGameEngine::GetElapsedTime() const
 	{ return fLastElapsed; }
 
+	void PixelGameEngine::SetFrameRateLimit(const float fFramesPerSecond)
+	{
+		fFrameRateLimit = std::max(fFramesPerSecond, 0.0f);
+		tpNextFrame = std::chrono::steady_clock::now();
+	}
+
+	float PixelGameEngine::GetFrameRateLimit() const
+	{ return fFrameRateLimit; }
+
+	void PixelGameEngine::SetFixedUpdateRate(const float fUpdatesPerSecond)
+	{
+		fFixedStep = fUpdatesPerSecond > 0.0f ? 1.0f / fUpdatesPerSecond : 0.0f;
+		fFixedTimeOwed = 0.0f;
+	}
+
+	void PixelGameEngine::EnableIdleMode(const bool bEnable, const float fWakeInterval)
+	{
+		fIdleWakeInterval = fWakeInterval;
+		if (bEnable == bIdleMode) return;
+		if (bEnable)
+		{
+			// Nothing waits while idle mode is off, so any wake left from turning
+			// it off is stale
+			if (platform) platform->ClearSystemEventWake();
+			bIdleMode = true;
+		}
+		else
+		{
+			// Off first, so a waiting engine that wakes does not wait again
+			bIdleMode = false;
+			WakeIdle();
+		}
+	}
+
+	void PixelGameEngine::RequestRedraw()
+	{
+		// Without idle mode every frame is drawn anyway
+		if (bIdleMode) WakeIdle();
+	}
+
+	void PixelGameEngine::WakeIdle()
+	{
+		// The platform is woken before the flag is set, so a wait that finds the
+		// flag set can clear the platform's wake along with it
+		if (platform) platform->WakeSystemEvent();
+		{
+			std::unique_lock<std::mutex> lock(muxIdle);
+			bIdleWake = true;
+		}
+		cvIdle.notify_one();
+	}
+
 	const olc::vi2d& PixelGameEngine::GetWindowSize() const
 	{ return vWindowSize; }
 
@@ -2446,6 +4069,18 @@ namespace olc
 	bool PixelGameEngine::Draw(int32_t x, int32_t y, Pixel p)
 	{
 		if (!pDrawTarget) return false;
+		if (x < vClipMin.x || y < vClipMin.y || x >= vClipMax.x || y >= vClipMax.y) return false;
+
+		if (IsDeferring())
+		{
+			if (x < 0 || x >= pDrawTarget->width || y < 0 || y >= pDrawTarget->height) return false;
+			FillSpan(x, y, 1, p);
+			return true;
+		}
+
+		// The clip keeps x and y from being negative
+		if (x < pDrawTarget->width && y < pDrawTarget->height && (nPixelMode != Pixel::MASK || p.a == 255))
+			statsFrame.nPixelsDrawn[nPixelMode]++;
 
 		if (nPixelMode == Pixel::NORMAL)
 		{
@@ -2460,23 +4095,224 @@ namespace olc
 
 		if (nPixelMode == Pixel::ALPHA)
 		{
-			Pixel d = pDrawTarget->GetPixel(x, y);
-			float a = (float)(p.a / 255.0f) * fBlendFactor;
-			float c = 1.0f - a;
-			float r = a * (float)p.r + c * (float)d.r;
-			float g = a * (float)p.g + c * (float)d.g;
-			float b = a * (float)p.b + c * (float)d.b;
-			return pDrawTarget->SetPixel(x, y, Pixel((uint8_t)r, (uint8_t)g, (uint8_t)b/*, (uint8_t)(p.a * fBlendFactor)*/));
+			return pDrawTarget->SetPixel(x, y, blend::Blend(p, pDrawTarget->GetPixel(x, y), blend::BlendFactor(fBlendFactor)));
 		}
 
 		if (nPixelMode == Pixel::CUSTOM)
 		{
+			if (funcPixelModeSpan)
+			{
+				if (x < 0 || x >= pDrawTarget->width || y < 0 || y >= pDrawTarget->height) return false;
+				funcPixelModeSpan(x, y, 1, &p, pDrawTarget->pColData.data() + size_t(y) * size_t(pDrawTarget->width) + x);
+				pDrawTarget->MarkDirty(x, y, 1, 1);
+				return true;
+			}
 			return pDrawTarget->SetPixel(x, y, funcPixelMode(x, y, p, pDrawTarget->GetPixel(x, y)));
 		}
 
 		return false;
 	}
 
+	bool PixelGameEngine::IsDeferring() const
+	{ return bDeferredDraw && bDrawTargetIsLayer; }
+
+	// Records a clipped span into the tile covering its row, so per tile the
+	// original draw order is kept
+	template<typename Mode>
+	void PixelGameEngine::DeferSpan(const Mode& mode, int32_t x, int32_t y, int32_t w, Pixel p, const Pixel* pSrc)
+	{
+		DeferredSpan span = { pDrawTarget, x, y, w, Pixel::NORMAL, 0, p, nDeferredNoSource };
+		if constexpr (std::is_same_v<Mode, pixelmode::Mask>)
+			span.nMode = Pixel::MASK;
+		if constexpr (std::is_same_v<Mode, pixelmode::Alpha>)
+		{
+			span.nMode = Pixel::ALPHA;
+			span.nParam = mode.nBlend;
+		}
+		if constexpr (std::is_same_v<Mode, pixelmode::Custom>)
+		{
+			// Functions are only copied when the user has changed them
+			if (nDeferredCustomVersion != nCustomModeVersion)
+			{
+				vDeferredCustom.emplace_back(funcPixelMode, funcPixelModeSpan);
+				nDeferredCustomVersion = nCustomModeVersion;
+			}
+			span.nMode = Pixel::CUSTOM;
+			span.nParam = uint32_t(vDeferredCustom.size() - 1);
+		}
+
+		// Source rows are often scratch, or may change before the flush, so copy them
+		if (pSrc != nullptr)
+		{
+			span.nSource = uint32_t(vDeferredSource.size());
+			vDeferredSource.insert(vDeferredSource.end(), pSrc, pSrc + w);
+		}
+
+		const size_t nTile = size_t(y / nDeferredTileHeight);
+		if (nTile >= vDeferredTiles.size()) vDeferredTiles.resize(nTile + 1);
+		vDeferredTiles[nTile].push_back(span);
+	}
+
+	template<typename F>
+	void PixelGameEngine::DispatchPixelMode(F&& f)
+	{
+		switch (nPixelMode)
+		{
+		case Pixel::NORMAL: f(pixelmode::Normal{}); break;
+		case Pixel::MASK:   f(pixelmode::Mask{}); break;
+		case Pixel::ALPHA:  f(pixelmode::Alpha{ blend::BlendFactor(fBlendFactor) }); break;
+		case Pixel::CUSTOM: f(pixelmode::Custom{ funcPixelMode, funcPixelModeSpan, vSpanFill }); break;
+		}
+	}
+
+	template<typename F>
+	void PixelGameEngine::RasteriseTriangle(const olc::vf2d& v0, const olc::vf2d& v1, const olc::vf2d& v2, F&& fnSpan)
+	{
+		if (!pDrawTarget) return;
+		const double vx[3] = { v0.x, v1.x, v2.x }, vy[3] = { v0.y, v1.y, v2.y };
+		raster::SnapTriangle(vx, vy, [&](const int64_t* x, const int64_t* y) { RasteriseSnapped(x[0], y[0], x[1], y[1], x[2], y[2], fnSpan); });
+	}
+
+	template<typename F>
+	void PixelGameEngine::RasteriseSnapped(int64_t x0, int64_t y0, int64_t x1, int64_t y1, int64_t x2, int64_t y2, F& fnSpan)
+	{
+		// Wind consistently so the inside is positive for all edges
+		const int64_t nArea = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+		if (nArea == 0) return;
+		if (nArea < 0) { std::swap(x1, x2); std::swap(y1, y2); }
+
+		raster::Edge e[3];
+		e[0].Setup(x0, y0, x1, y1);
+		e[1].Setup(x1, y1, x2, y2);
+		e[2].Setup(x2, y2, x0, y0);
+
+		// Candidate pixels, clipped to the draw target and clip rectangle
+		const olc::vi2d vClipLo = ClipMin(), vClipHi = ClipMax();
+		const int32_t nMinX = int32_t(std::max<int64_t>(raster::CeilDiv(std::min({ x0, x1, x2 })), vClipLo.x));
+		const int32_t nMinY = int32_t(std::max<int64_t>(raster::CeilDiv(std::min({ y0, y1, y2 })), vClipLo.y));
+		const int32_t nMaxX = int32_t(std::min<int64_t>(raster::FloorDiv(std::max({ x0, x1, x2 })), vClipHi.x - 1));
+		const int32_t nMaxY = int32_t(std::min<int64_t>(raster::FloorDiv(std::max({ y0, y1, y2 })), vClipHi.y - 1));
+		if (nMinX > nMaxX || nMinY > nMaxY) return;
+
+		// Walk 8x8 blocks a strip at a time. Blocks fully outside any edge are
+		// skipped, blocks fully inside all edges need no per pixel tests. Being
+		// convex, each row's coverage is one run, so a strip emits a span per row
+		int32_t vRowMin[raster::nBlock], vRowMax[raster::nBlock];
+		for (int32_t by = nMinY; by <= nMaxY; by += raster::nBlock)
+		{
+			const int32_t by1 = std::min(by + raster::nBlock - 1, nMaxY);
+			std::fill_n(vRowMin, raster::nBlock, INT32_MAX);
+			std::fill_n(vRowMax, raster::nBlock, -1);
+
+			for (int32_t bx = nMinX; bx <= nMaxX; bx += raster::nBlock)
+			{
+				const int32_t bx1 = std::min(bx + raster::nBlock - 1, nMaxX);
+
+				int64_t E[3];
+				bool bReject = false, bAccept = true;
+				for (int k = 0; k < 3; k++)
+				{
+					E[k] = e[k].At(bx, by);
+					const int64_t dx = e[k].A * (bx1 - bx), dy = e[k].B * (by1 - by);
+					if (E[k] + std::max<int64_t>(dx, 0) + std::max<int64_t>(dy, 0) < 0) bReject = true;
+					if (E[k] + std::min<int64_t>(dx, 0) + std::min<int64_t>(dy, 0) < 0) bAccept = false;
+				}
+				if (bReject) continue;
+
+				for (int32_t r = 0; r <= by1 - by; r++)
+				{
+					int32_t nFirst = bx, nLast = bx1;
+					if (!bAccept)
+					{
+						const int64_t Er[3] = { E[0] + e[0].B * r, E[1] + e[1].B * r, E[2] + e[2].B * r };
+						const uint32_t nMask = raster::RowMask(e, Er, bx1 - bx + 1);
+						if (nMask == 0) continue;
+						int32_t i = 0, j = raster::nBlock - 1;
+						while (!(nMask & (1u << i))) i++;
+						while (!(nMask & (1u << j))) j--;
+						nFirst = bx + i; nLast = bx + j;
+					}
+					vRowMin[r] = std::min(vRowMin[r], nFirst);
+					vRowMax[r] = std::max(vRowMax[r], nLast);
+				}
+			}
+
+			for (int32_t r = 0; r <= by1 - by; r++)
+				if (vRowMin[r] <= vRowMax[r])
+					fnSpan(by + r, vRowMin[r], vRowMax[r] + 1);
+		}
+	}
+
+	// The span equivalent of Draw(), clipping is resolved once per row rather
+	// than once per pixel, which is where fill primitives spend their time
+	template<typename Mode>
+	void PixelGameEngine::FillSpan(const Mode& mode, int32_t x, int32_t y, int32_t w, Pixel p)
+	{
+		if (!pDrawTarget) return;
+		const olc::vi2d vMin = ClipMin(), vMax = ClipMax();
+		if (y < vMin.y || y >= vMax.y) return;
+
+		int32_t x2 = std::min(x + w, vMax.x);
+		if (x < vMin.x) x = vMin.x;
+		if (x >= x2) return;
+
+		pDrawTarget->MarkDirty(x, y, x2 - x, 1);
+		statsFrame.nPixelsDrawn[Mode::nMode] += pixelmode::Written<Mode>(x2 - x, p, nullptr);
+		if (IsDeferring())
+			return DeferSpan(mode, x, y, x2 - x, p, nullptr);
+
+		mode.Fill(x, y, pDrawTarget->pColData.data() + size_t(y) * size_t(pDrawTarget->width) + x, x2 - x, p);
+	}
+
+	template<typename Mode>
+	void PixelGameEngine::DrawSpan(const Mode& mode, int32_t x, int32_t y, int32_t w, const Pixel* pSrc)
+	{
+		if (!pDrawTarget) return;
+		const olc::vi2d vMin = ClipMin(), vMax = ClipMax();
+		if (y < vMin.y || y >= vMax.y) return;
+
+		int32_t x2 = std::min(x + w, vMax.x);
+		if (x < vMin.x) { pSrc += vMin.x - x; x = vMin.x; }
+		if (x >= x2) return;
+
+		pDrawTarget->MarkDirty(x, y, x2 - x, 1);
+		statsFrame.nPixelsDrawn[Mode::nMode] += pixelmode::Written<Mode>(x2 - x, Pixel(), pSrc);
+		if (IsDeferring())
+			return DeferSpan(mode, x, y, x2 - x, Pixel(), pSrc);
+
+		mode.Copy(x, y, pDrawTarget->pColData.data() + size_t(y) * size_t(pDrawTarget->width) + x, pSrc, x2 - x);
+	}
+
+	template<typename Mode>
+	void PixelGameEngine::DrawGlyph(const Mode& mode, int32_t x, int32_t y, uint64_t nMask, Pixel col, int32_t scale)
+	{
+		// Glyphs wholly outside the clip are skipped, not clipped row by row
+		const olc::vi2d vMin = ClipMin(), vMax = ClipMax();
+		if (x >= vMax.x || y >= vMax.y || x + 8 * scale <= vMin.x || y + 8 * scale <= vMin.y) return;
+
+		for (int32_t j = 0; nMask != 0; j++, nMask >>= 8)
+		{
+			uint32_t nRow = uint32_t(nMask & 0xFF);
+			int32_t i = 0;
+			while (nRow != 0)
+			{
+				// Skip clear bits, then measure the run of set bits that follows
+				while (!(nRow & 1)) { nRow >>= 1; i++; }
+				int32_t nRun = 0;
+				while (nRow & 1) { nRow >>= 1; nRun++; }
+				for (int32_t js = 0; js < scale; js++)
+					FillSpan(mode, x + i * scale, y + j * scale + js, nRun * scale, col);
+				i += nRun;
+			}
+		}
+	}
+
+	void PixelGameEngine::FillSpan(int32_t x, int32_t y, int32_t w, Pixel p)
+	{ DispatchPixelMode([&](const auto& mode) { FillSpan(mode, x, y, w, p); }); }
+
+	void PixelGameEngine::DrawSpan(int32_t x, int32_t y, int32_t w, const Pixel* pSrc)
+	{ DispatchPixelMode([&](const auto& mode) { DrawSpan(mode, x, y, w, pSrc); }); }
+
 
 	void PixelGameEngine::DrawLine(const olc::vi2d& pos1, const olc::vi2d& pos2, Pixel p, uint32_t pattern)
 	{ DrawLine(pos1.x, pos1.y, pos2.x, pos2.y, p, pattern); }
@@ -2494,6 +4330,10 @@ namespace olc
 		x1 = p1.x; y1 = p1.y;
 		x2 = p2.x; y2 = p2.y;
 
+		// Mark the extent once, so the per pixel dirty tracking finds it covered
+		if (pDrawTarget)
+			pDrawTarget->MarkDirty(std::min(x1, x2), std::min(y1, y2), std::abs(x2 - x1) + 1, std::abs(y2 - y1) + 1);
+
 		// straight lines idea by gurkanctn
 		if (dx == 0) // Line is vertical
 		{
@@ -2571,7 +4411,8 @@ namespace olc
 
 	void PixelGameEngine::DrawCircle(int32_t x, int32_t y, int32_t radius, Pixel p, uint8_t mask)
 	{ // Thanks to IanM-Matrix1 #PR121
-		if (radius < 0 || x < -radius || y < -radius || x - GetDrawTargetWidth() > radius || y - GetDrawTargetHeight() > radius)
+		const olc::vi2d vMin = ClipMin(), vMax = ClipMax();
+		if (radius < 0 || x < vMin.x - radius || y < vMin.y - radius || x - vMax.x > radius || y - vMax.y > radius)
 			return;
 
 		if (radius > 0)
@@ -2610,38 +4451,44 @@ namespace olc
 
 	void PixelGameEngine::FillCircle(int32_t x, int32_t y, int32_t radius, Pixel p)
 	{ // Thanks to IanM-Matrix1 #PR121
-		if (radius < 0 || x < -radius || y < -radius || x - GetDrawTargetWidth() > radius || y - GetDrawTargetHeight() > radius)
+		const olc::vi2d vMin = ClipMin(), vMax = ClipMax();
+		if (radius < 0 || x < vMin.x - radius || y < vMin.y - radius || x - vMax.x > radius || y - vMax.y > radius)
 			return;
 
 		if (radius > 0)
 		{
-			int x0 = 0;
-			int y0 = radius;
-			int d = 3 - 2 * radius;
+			if (pDrawTarget)
+				pDrawTarget->MarkDirty(x - radius, y - radius, radius * 2 + 1, radius * 2 + 1);
 
-			auto drawline = [&](int sx, int ex, int y)
+			DispatchPixelMode([&](const auto& mode)
 			{
-				for (int x = sx; x <= ex; x++)
-					Draw(x, y, p);
-			};
+				int x0 = 0;
+				int y0 = radius;
+				int d = 3 - 2 * radius;
 
-			while (y0 >= x0)
-			{
-				drawline(x - y0, x + y0, y - x0);
-				if (x0 > 0)	drawline(x - y0, x + y0, y + x0);
+				auto drawline = [&](int sx, int ex, int y)
+				{
+					FillSpan(mode, sx, y, ex - sx + 1, p);
+				};
 
-				if (d < 0)
-					d += 4 * x0++ + 6;
-				else
+				while (y0 >= x0)
 				{
-					if (x0 != y0)
+					drawline(x - y0, x + y0, y - x0);
+					if (x0 > 0)	drawline(x - y0, x + y0, y + x0);
+
+					if (d < 0)
+						d += 4 * x0++ + 6;
+					else
 					{
-						drawline(x - x0, x + x0, y - y0);
-						drawline(x - x0, x + x0, y + y0);
+						if (x0 != y0)
+						{
+							drawline(x - x0, x + x0, y - y0);
+							drawline(x - x0, x + x0, y + y0);
+						}
+						d += 4 * (x0++ - y0--) + 10;
 					}
-					d += 4 * (x0++ - y0--) + 10;
 				}
-			}
+			});
 		}
 		else
 			Draw(x, y, p);
@@ -2660,13 +4507,23 @@ namespace olc
 
 	void PixelGameEngine::Clear(Pixel p)
 	{
+		// Clipped, only the clip rectangle is cleared
+		if (IsDeferring() || !vClipStack.empty())
+		{
+			const olc::vi2d vMin = ClipMin(), vMax = ClipMax();
+			for (int32_t y = vMin.y; y < vMax.y; y++)
+				FillSpan(pixelmode::Normal{}, vMin.x, y, vMax.x - vMin.x, p);
+			return;
+		}
+
 		int pixels = GetDrawTargetWidth() * GetDrawTargetHeight();
-		Pixel* m = GetDrawTarget()->GetData();
+		GetDrawTarget()->MarkDirty();
+		Pixel* m = GetDrawTarget()->pColData.data();
 		for (int i = 0; i < pixels; i++) m[i] = p;
 	}
 
 	void PixelGameEngine::ClearBuffer(Pixel p, bool bDepth)
-	{ renderer->ClearBuffer(p, bDepth);	}
+	{ adv_RunOnRenderThread([&] { renderer->ClearBuffer(p, bDepth); }); }
 
 	olc::Sprite* PixelGameEngine::GetFontSprite()
 	{ return fontRenderable.Sprite(); }
@@ -2675,11 +4532,16 @@ namespace olc
 	{
 		// https://en.wikipedia.org/wiki/Cohen%E2%80%93Sutherland_algorithm
 		static constexpr int SEG_I = 0b0000, SEG_L = 0b0001, SEG_R = 0b0010, SEG_B = 0b0100, SEG_T = 0b1000;
-		auto Segment = [&vScreenSize = vScreenSize](const olc::vi2d& v)
+		// Lines keep to the draw target and clip rectangle, taking the far edges
+		// as the last pixels inside
+		const olc::vi2d vMin = ClipMin(), vMax = ClipMax() - olc::vi2d(1, 1);
+		if (vMin.x > vMax.x || vMin.y > vMax.y) return false;
+
+		auto Segment = [&](const olc::vi2d& v)
 		{
 			int i = SEG_I;
-			if (v.x < 0) i |= SEG_L; else if (v.x > vScreenSize.x) i |= SEG_R;
-			if (v.y < 0) i |= SEG_B; else if (v.y > vScreenSize.y) i |= SEG_T;
+			if (v.x < vMin.x) i |= SEG_L; else if (v.x > vMax.x) i |= SEG_R;
+			if (v.y < vMin.y) i |= SEG_B; else if (v.y > vMax.y) i |= SEG_T;
 			return i;
 		};
 
@@ -2693,10 +4555,10 @@ namespace olc
 			{
 				int s3 = s2 > s1 ? s2 : s1;
 				olc::vi2d n;
-				if (s3 & SEG_T) { n.x = in_p1.x + (in_p2.x - in_p1.x) * (vScreenSize.y - in_p1.y) / (in_p2.y - in_p1.y); n.y = vScreenSize.y; }
-				else if (s3 & SEG_B) { n.x = in_p1.x + (in_p2.x - in_p1.x) * (0 - in_p1.y) / (in_p2.y - in_p1.y); n.y = 0; }
-				else if (s3 & SEG_R) { n.x = vScreenSize.x; n.y = in_p1.y + (in_p2.y - in_p1.y) * (vScreenSize.x - in_p1.x) / (in_p2.x - in_p1.x); }
-				else if (s3 & SEG_L) { n.x = 0; n.y = in_p1.y + (in_p2.y - in_p1.y) * (0 - in_p1.x) / (in_p2.x - in_p1.x); }
+				if (s3 & SEG_T) { n.x = in_p1.x + (in_p2.x - in_p1.x) * (vMax.y - in_p1.y) / (in_p2.y - in_p1.y); n.y = vMax.y; }
+				else if (s3 & SEG_B) { n.x = in_p1.x + (in_p2.x - in_p1.x) * (vMin.y - in_p1.y) / (in_p2.y - in_p1.y); n.y = vMin.y; }
+				else if (s3 & SEG_R) { n.x = vMax.x; n.y = in_p1.y + (in_p2.y - in_p1.y) * (vMax.x - in_p1.x) / (in_p2.x - in_p1.x); }
+				else if (s3 & SEG_L) { n.x = vMin.x; n.y = in_p1.y + (in_p2.y - in_p1.y) * (vMin.x - in_p1.x) / (in_p2.x - in_p1.x); }
 				if (s3 == s1) { in_p1 = n; s1 = Segment(in_p1); }
 				else { in_p2 = n; s2 = Segment(in_p2); }
 			}
@@ -2704,6 +4566,30 @@ namespace olc
 		return true;
 	}
 
+	void PixelGameEngine::PushClip(const olc::vi2d& pos, const olc::vi2d& size)
+	{ PushClip(pos.x, pos.y, size.x, size.y); }
+
+	void PixelGameEngine::PushClip(int32_t x, int32_t y, int32_t w, int32_t h)
+	{
+		vClipStack.push_back({ vClipMin, vClipMax });
+		vClipMin = vClipMin.max({ x, y });
+		vClipMax = vClipMax.min({ x + std::max(w, 0), y + std::max(h, 0) });
+	}
+
+	void PixelGameEngine::PopClip()
+	{
+		if (vClipStack.empty()) return;
+		vClipMin = vClipStack.back().first;
+		vClipMax = vClipStack.back().second;
+		vClipStack.pop_back();
+	}
+
+	olc::vi2d PixelGameEngine::ClipMin() const
+	{ return vClipMin; }
+
+	olc::vi2d PixelGameEngine::ClipMax() const
+	{ return pDrawTarget ? vClipMax.min(pDrawTarget->Size()) : olc::vi2d(0, 0); }
+
 	void PixelGameEngine::EnablePixelTransfer(const bool bEnable)
 	{
 		bSuspendTextureTransfer = !bEnable;
@@ -2718,19 +4604,21 @@ namespace olc
 		int32_t x2 = x + w;
 		int32_t y2 = y + h;
 
-		if (x < 0) x = 0;
-		if (x >= (int32_t)GetDrawTargetWidth()) x = (int32_t)GetDrawTargetWidth();
-		if (y < 0) y = 0;
-		if (y >= (int32_t)GetDrawTargetHeight()) y = (int32_t)GetDrawTargetHeight();
+		// Clamp to the clip, so rows outside it are never visited
+		const olc::vi2d vMin = ClipMin(), vMax = ClipMax();
+		x = std::min(std::max(x, vMin.x), vMax.x);
+		y = std::min(std::max(y, vMin.y), vMax.y);
+		x2 = std::min(std::max(x2, vMin.x), vMax.x);
+		y2 = std::min(std::max(y2, vMin.y), vMax.y);
 
-		if (x2 < 0) x2 = 0;
-		if (x2 >= (int32_t)GetDrawTargetWidth()) x2 = (int32_t)GetDrawTargetWidth();
-		if (y2 < 0) y2 = 0;
-		if (y2 >= (int32_t)GetDrawTargetHeight()) y2 = (int32_t)GetDrawTargetHeight();
+		if (pDrawTarget)
+			pDrawTarget->MarkDirty(x, y, x2 - x, y2 - y);
 
-		for (int i = x; i < x2; i++)
+		DispatchPixelMode([&](const auto& mode)
+		{
 			for (int j = y; j < y2; j++)
-				Draw(i, j, p);
+				FillSpan(mode, x, j, x2 - x, p);
+		});
 	}
 
 	void PixelGameEngine::DrawTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p)
@@ -2746,304 +4634,205 @@ namespace olc
 	void PixelGameEngine::FillTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p)
 	{ FillTriangle(pos1.x, pos1.y, pos2.x, pos2.y, pos3.x, pos3.y, p); }
 
-	// https://www.avrfreaks.net/sites/default/files/triangles.c
-	void PixelGameEngine::FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p)
-	{
-		auto drawline = [&](int sx, int ex, int ny) { for (int i = sx; i <= ex; i++) Draw(i, ny, p); };
-
-		int t1x, t2x, y, minx, maxx, t1xp, t2xp;
-		bool changed1 = false;
-		bool changed2 = false;
-		int signx1, signx2, dx1, dy1, dx2, dy2;
-		int e1, e2;
-		// Sort vertices
-		if (y1 > y2) { std::swap(y1, y2); std::swap(x1, x2); }
-		if (y1 > y3) { std::swap(y1, y3); std::swap(x1, x3); }
-		if (y2 > y3) { std::swap(y2, y3); std::swap(x2, x3); }
-
-		t1x = t2x = x1; y = y1;   // Starting points
-		dx1 = (int)(x2 - x1);
-		if (dx1 < 0) { dx1 = -dx1; signx1 = -1; }
-		else signx1 = 1;
-		dy1 = (int)(y2 - y1);
-
-		dx2 = (int)(x3 - x1);
-		if (dx2 < 0) { dx2 = -dx2; signx2 = -1; }
-		else signx2 = 1;
-		dy2 = (int)(y3 - y1);
-
-		if (dy1 > dx1) { std::swap(dx1, dy1); changed1 = true; }
-		if (dy2 > dx2) { std::swap(dy2, dx2); changed2 = true; }
-
-		e2 = (int)(dx2 >> 1);
-		// Flat top, just process the second half
-		if (y1 == y2) goto next;
-		e1 = (int)(dx1 >> 1);
-
-		for (int i = 0; i < dx1;) {
-			t1xp = 0; t2xp = 0;
-			if (t1x < t2x) { minx = t1x; maxx = t2x; }
-			else { minx = t2x; maxx = t1x; }
-			// process first line until y value is about to change
-			while (i < dx1) {
-				i++;
-				e1 += dy1;
-				while (e1 >= dx1) {
-					e1 -= dx1;
-					if (changed1) t1xp = signx1;//t1x += signx1;
-					else          goto next1;
-				}
-				if (changed1) break;
-				else t1x += signx1;
-			}
-			// Move line
-		next1:
-			// process second line until y value is about to change
-			while (1) {
-				e2 += dy2;
-				while (e2 >= dx2) {
-					e2 -= dx2;
-					if (changed2) t2xp = signx2;//t2x += signx2;
-					else          goto next2;
-				}
-				if (changed2)     break;
-				else              t2x += signx2;
-			}
-		next2:
-			if (minx > t1x) minx = t1x;
-			if (minx > t2x) minx = t2x;
-			if (maxx < t1x) maxx = t1x;
-			if (maxx < t2x) maxx = t2x;
-			drawline(minx, maxx, y);    // Draw line from min to max points found on the y
-										// Now increase y
-			if (!changed1) t1x += signx1;
-			t1x += t1xp;
-			if (!changed2) t2x += signx2;
-			t2x += t2xp;
-			y += 1;
-			if (y == y2) break;
-		}
-	next:
-		// Second half
-		dx1 = (int)(x3 - x2); if (dx1 < 0) { dx1 = -dx1; signx1 = -1; }
-		else signx1 = 1;
-		dy1 = (int)(y3 - y2);
-		t1x = x2;
-
-		if (dy1 > dx1) {   // swap values
-			std::swap(dy1, dx1);
-			changed1 = true;
-		}
-		else changed1 = false;
-
-		e1 = (int)(dx1 >> 1);
-
-		for (int i = 0; i <= dx1; i++) {
-			t1xp = 0; t2xp = 0;
-			if (t1x < t2x) { minx = t1x; maxx = t2x; }
-			else { minx = t2x; maxx = t1x; }
-			// process first line until y value is about to change
-			while (i < dx1) {
-				e1 += dy1;
-				while (e1 >= dx1) {
-					e1 -= dx1;
-					if (changed1) { t1xp = signx1; break; }//t1x += signx1;
-					else          goto next3;
-				}
-				if (changed1) break;
-				else   	   	  t1x += signx1;
-				if (i < dx1) i++;
-			}
-		next3:
-			// process second line until y value is about to change
-			while (t2x != x3) {
-				e2 += dy2;
-				while (e2 >= dx2) {
-					e2 -= dx2;
-					if (changed2) t2xp = signx2;
-					else          goto next4;
-				}
-				if (changed2)     break;
-				else              t2x += signx2;
-			}
-		next4:
-
-			if (minx > t1x) minx = t1x;
-			if (minx > t2x) minx = t2x;
-			if (maxx < t1x) maxx = t1x;
-			if (maxx < t2x) maxx = t2x;
-			drawline(minx, maxx, y);
-			if (!changed1) t1x += signx1;
-			t1x += t1xp;
-			if (!changed2) t2x += signx2;
-			t2x += t2xp;
-			y += 1;
-			if (y > y3) return;
-		}
-	}
-
-	void PixelGameEngine::FillTexturedTriangle(std::vector<olc::vf2d> vPoints, std::vector<olc::vf2d> vTex, std::vector<olc::Pixel> vColour, olc::Sprite* sprTex)
-	{
-		olc::vi2d p1 = vPoints[0];
-		olc::vi2d p2 = vPoints[1];
-		olc::vi2d p3 = vPoints[2];
-
-		if (p2.y < p1.y){std::swap(p1.y, p2.y); std::swap(p1.x, p2.x); std::swap(vTex[0].x, vTex[1].x); std::swap(vTex[0].y, vTex[1].y); std::swap(vColour[0], vColour[1]);}
-		if (p3.y < p1.y){std::swap(p1.y, p3.y); std::swap(p1.x, p3.x); std::swap(vTex[0].x, vTex[2].x); std::swap(vTex[0].y, vTex[2].y); std::swap(vColour[0], vColour[2]);}
-		if (p3.y < p2.y){std::swap(p2.y, p3.y); std::swap(p2.x, p3.x); std::swap(vTex[1].x, vTex[2].x); std::swap(vTex[1].y, vTex[2].y); std::swap(vColour[1], vColour[2]);}
-
-		olc::vi2d dPos1 = p2 - p1;
-		olc::vf2d dTex1 = vTex[1] - vTex[0];
-		int dcr1 = vColour[1].r - vColour[0].r;
-		int dcg1 = vColour[1].g - vColour[0].g;
-		int dcb1 = vColour[1].b - vColour[0].b;
-		int dca1 = vColour[1].a - vColour[0].a;
-
-		olc::vi2d dPos2 = p3 - p1;
-		olc::vf2d dTex2 = vTex[2] - vTex[0];
-		int dcr2 = vColour[2].r - vColour[0].r;
-		int dcg2 = vColour[2].g - vColour[0].g;
-		int dcb2 = vColour[2].b - vColour[0].b;
-		int dca2 = vColour[2].a - vColour[0].a;
-
-		float dax_step = 0, dbx_step = 0, dcr1_step = 0, dcr2_step = 0,	dcg1_step = 0, dcg2_step = 0, dcb1_step = 0, dcb2_step = 0,	dca1_step = 0, dca2_step = 0;
-		olc::vf2d vTex1Step, vTex2Step;
-
-		if (dPos1.y)
+	void PixelGameEngine::FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p)
+	{
+		if (pDrawTarget)
 		{
-			dax_step = dPos1.x / (float)abs(dPos1.y);
-			vTex1Step = dTex1 / (float)abs(dPos1.y);
-			dcr1_step = dcr1 / (float)abs(dPos1.y);
-			dcg1_step = dcg1 / (float)abs(dPos1.y);
-			dcb1_step = dcb1 / (float)abs(dPos1.y);
-			dca1_step = dca1 / (float)abs(dPos1.y);
+			// Bounds are clamped first, as far off vertices would overflow the size
+			const int32_t nMinX = std::max(std::min({ x1, x2, x3 }), 0), nMinY = std::max(std::min({ y1, y2, y3 }), 0);
+			const int32_t nMaxX = std::min(std::max({ x1, x2, x3 }), pDrawTarget->width - 1), nMaxY = std::min(std::max({ y1, y2, y3 }), pDrawTarget->height - 1);
+			if (nMinX <= nMaxX && nMinY <= nMaxY)
+				pDrawTarget->MarkDirty(nMinX, nMinY, nMaxX - nMinX + 1, nMaxY - nMinY + 1);
 		}
 
-		if (dPos2.y)
+		DispatchPixelMode([&](const auto& mode)
 		{
-			dbx_step = dPos2.x / (float)abs(dPos2.y);
-			vTex2Step = dTex2 / (float)abs(dPos2.y);
-			dcr2_step = dcr2 / (float)abs(dPos2.y);
-			dcg2_step = dcg2 / (float)abs(dPos2.y);
-			dcb2_step = dcb2 / (float)abs(dPos2.y);
-			dca2_step = dca2 / (float)abs(dPos2.y);
-		}
-
-		olc::vi2d vStart;
-		olc::vi2d vEnd;
-		int vStartIdx;
+			RasteriseTriangle({ float(x1), float(y1) }, { float(x2), float(y2) }, { float(x3), float(y3) },
+				[&](int32_t y, int32_t sx, int32_t ex) { FillSpan(mode, sx, y, ex - sx, p); });
+		});
+	}
 
-		for (int pass = 0; pass < 2; pass++)
-		{
-			if (pass == 0)
-			{
-				vStart = p1; vEnd = p2;	vStartIdx = 0;
-			}
-			else
-			{
-				dPos1 = p3 - p2;
-				dTex1 = vTex[2] - vTex[1];
-				dcr1 = vColour[2].r - vColour[1].r;
-				dcg1 = vColour[2].g - vColour[1].g;
-				dcb1 = vColour[2].b - vColour[1].b;
-				dca1 = vColour[2].a - vColour[1].a;
-				dcr1_step = 0; dcg1_step = 0; dcb1_step = 0; dca1_step = 0;
+	void PixelGameEngine::FillTexturedTriangle(const std::vector<olc::vf2d>& vPoints, const std::vector<olc::vf2d>& vTex, const std::vector<olc::Pixel>& vColour, olc::Sprite* sprTex)
+	{
+		if (vPoints.size() < 3 || vTex.size() < 3 || vColour.size() < 3)
+			return;
+		FillTexturedTriangle(vPoints.data(), vTex.data(), vColour.data(), sprTex);
+	}
 
-				if (dPos2.y) dbx_step = dPos2.x / (float)abs(dPos2.y);
-				if (dPos1.y)
-				{
-					dax_step = dPos1.x / (float)abs(dPos1.y);
-					vTex1Step = dTex1 / (float)abs(dPos1.y);
-					dcr1_step = dcr1 / (float)abs(dPos1.y);
-					dcg1_step = dcg1 / (float)abs(dPos1.y);
-					dcb1_step = dcb1 / (float)abs(dPos1.y);
-					dca1_step = dca1 / (float)abs(dPos1.y);
-				}
+	void PixelGameEngine::FillTexturedTriangle(const olc::vf2d* pPos, const olc::vf2d* pTex, const olc::Pixel* pCol, olc::Sprite* sprTex)
+	{ ShadeTriangle(pPos, pTex, pCol, nullptr, sprTex); }
 
-				vStart = p2; vEnd = p3; vStartIdx = 1;
-			}
+	void PixelGameEngine::ShadeTriangle(const olc::vf2d* pPos, const olc::vf2d* pTex, const olc::Pixel* pCol, const float* pDepth, olc::Sprite* sprTex)
+	{
+		if (!pDrawTarget) return;
+		float* pDepthBuffer = pDepth != nullptr && pDrawTarget->HasDepth() ? pDrawTarget->GetDepth() : nullptr;
 
-			if (dPos1.y)
+		// Untextured and a single colour is just a flat fill
+		if (pDepthBuffer == nullptr && sprTex == nullptr && pCol[0] == pCol[1] && pCol[0] == pCol[2])
+		{
+			DispatchPixelMode([&](const auto& mode)
 			{
-				for (int i = vStart.y; i <= vEnd.y; i++)
-				{
-					int ax = int(vStart.x + (float)(i - vStart.y) * dax_step);
-					int bx = int(p1.x + (float)(i - p1.y) * dbx_step);
-
-					olc::vf2d tex_s(vTex[vStartIdx].x + (float)(i - vStart.y) * vTex1Step.x, vTex[vStartIdx].y + (float)(i - vStart.y) * vTex1Step.y);
-					olc::vf2d tex_e(vTex[0].x + (float)(i - p1.y) * vTex2Step.x, vTex[0].y + (float)(i - p1.y) * vTex2Step.y);
-
-					olc::Pixel col_s(vColour[vStartIdx].r + uint8_t((float)(i - vStart.y) * dcr1_step), vColour[vStartIdx].g + uint8_t((float)(i - vStart.y) * dcg1_step),
-						vColour[vStartIdx].b + uint8_t((float)(i - vStart.y) * dcb1_step), vColour[vStartIdx].a + uint8_t((float)(i - vStart.y) * dca1_step));
-
-					olc::Pixel col_e(vColour[0].r + uint8_t((float)(i - p1.y) * dcr2_step), vColour[0].g + uint8_t((float)(i - p1.y) * dcg2_step),
-						vColour[0].b + uint8_t((float)(i - p1.y) * dcb2_step), vColour[0].a + uint8_t((float)(i - p1.y) * dca2_step));
-
-					if (ax > bx) { std::swap(ax, bx); std::swap(tex_s, tex_e); std::swap(col_s, col_e); }
+				RasteriseTriangle(pPos[0], pPos[1], pPos[2],
+					[&](int32_t y, int32_t sx, int32_t ex) { FillSpan(mode, sx, y, ex - sx, pCol[0]); });
+			});
+			return;
+		}
 
-					float tstep = 1.0f / ((float)(bx - ax));
-					float t = 0.0f;
+		// Screen space gradients of r, g, b, a, u, v & depth, interpolated affinely
+		const olc::vf2d d1 = pPos[1] - pPos[0], d2 = pPos[2] - pPos[0];
+		const float fArea = d1.x * d2.y - d1.y * d2.x;
+		if (fArea == 0.0f) return;
+		const float fInvArea = 1.0f / fArea;
 
-					for (int j = ax; j < bx; j++)
+		float vA0[7], vDx[7], vDy[7];
+		auto Gradient = [&](int i, float a0, float a1, float a2)
+		{
+			vA0[i] = a0;
+			vDx[i] = ((a1 - a0) * d2.y - (a2 - a0) * d1.y) * fInvArea;
+			vDy[i] = ((a2 - a0) * d1.x - (a1 - a0) * d2.x) * fInvArea;
+		};
+		Gradient(0, pCol[0].r, pCol[1].r, pCol[2].r);
+		Gradient(1, pCol[0].g, pCol[1].g, pCol[2].g);
+		Gradient(2, pCol[0].b, pCol[1].b, pCol[2].b);
+		Gradient(3, pCol[0].a, pCol[1].a, pCol[2].a);
+		Gradient(4, pTex[0].x, pTex[1].x, pTex[2].x);
+		Gradient(5, pTex[0].y, pTex[1].y, pTex[2].y);
+		const int nAttribs = pDepthBuffer ? 7 : 6;
+		if (pDepthBuffer) Gradient(6, pDepth[0], pDepth[1], pDepth[2]);
+
+		auto Channel = [](float c) { return uint8_t(std::min(std::max(c + 0.5f, 0.0f), 255.0f)); };
+
+		DispatchPixelMode([&](const auto& mode)
+		{
+			RasteriseTriangle(pPos[0], pPos[1], pPos[2], [&](int32_t y, int32_t sx, int32_t ex)
+			{
+				// Shade the run into scratch, then write it in one go. With depth, the
+				// test comes first so hidden pixels are never shaded, and each run of
+				// visible pixels is written separately
+				vSpanBuffer.resize(size_t(ex - sx));
+				const float fx = float(sx) - pPos[0].x, fy = float(y) - pPos[0].y;
+				float a[7];
+				for (int i = 0; i < nAttribs; i++) a[i] = vA0[i] + vDx[i] * fx + vDy[i] * fy;
+				float* pZ = pDepthBuffer ? pDepthBuffer + size_t(y) * size_t(pDrawTarget->width) : nullptr;
+
+				int32_t nRun = sx;
+				for (int32_t x = sx; x < ex; x++)
+				{
+					if (pZ != nullptr)
 					{
-						olc::Pixel pixel = PixelLerp(col_s, col_e, t);
-						if (sprTex != nullptr) pixel *= sprTex->Sample(tex_s.lerp(tex_e, t));
-						Draw(j, i, pixel);
-						t += tstep;
+						if (a[6] < pZ[x])
+							pZ[x] = a[6];
+						else
+						{
+							if (nRun < x) DrawSpan(mode, nRun, y, x - nRun, &vSpanBuffer[nRun - sx]);
+							nRun = x + 1;
+							for (int i = 0; i < nAttribs; i++) a[i] += vDx[i];
+							continue;
+						}
 					}
+
+					olc::Pixel& pixel = vSpanBuffer[x - sx];
+					pixel = olc::Pixel(Channel(a[0]), Channel(a[1]), Channel(a[2]), Channel(a[3]));
+					if (sprTex != nullptr) pixel *= sprTex->Sample(a[4], a[5]);
+					for (int i = 0; i < nAttribs; i++) a[i] += vDx[i];
 				}
-			}
-		}			
+
+				if (nRun < ex) DrawSpan(mode, nRun, y, ex - nRun, &vSpanBuffer[nRun - sx]);
+			});
+		});
 	}
 
 	void PixelGameEngine::FillTexturedPolygon(const std::vector<olc::vf2d>& vPoints, const std::vector<olc::vf2d>& vTex, const std::vector<olc::Pixel>& vColour, olc::Sprite* sprTex, olc::DecalStructure structure)
+	{
+		const size_t nVertices = std::min({ vPoints.size(), vTex.size(), vColour.size() });
+		FillTexturedPolygon(vPoints.data(), vTex.data(), vColour.data(), nVertices, sprTex, structure);
+	}
+
+	void PixelGameEngine::FillTexturedPolygon(const olc::vf2d* pPoints, const olc::vf2d* pTex, const olc::Pixel* pColour, size_t nVertices, olc::Sprite* sprTex, olc::DecalStructure structure, const uint32_t* pIndices, size_t nIndices)
 	{
 		if (structure == olc::DecalStructure::LINE)
 		{
 			return; // Meaningless, so do nothing
 		}
 
-		if (vPoints.size() < 3 || vTex.size() < 3 || vColour.size() < 3)
+		const size_t nCount = pIndices ? nIndices : nVertices;
+		if (nVertices < 3 || nCount < 3)
+			return;
+
+		// Unindexed LIST and STRIP triangles are consecutive in the arrays already
+		if (pIndices == nullptr && structure != olc::DecalStructure::FAN)
+		{
+			const size_t nStep = structure == olc::DecalStructure::LIST ? 3 : 1;
+			for (size_t i = 0; i + 2 < nVertices; i += nStep)
+				FillTexturedTriangle(pPoints + i, pTex + i, pColour + i, sprTex);
 			return;
+		}
+
+		// Otherwise gather each triangle's vertices onto the stack
+		auto Triangle = [&](size_t a, size_t b, size_t c)
+		{
+			const size_t i[3] = { pIndices ? pIndices[a] : a, pIndices ? pIndices[b] : b, pIndices ? pIndices[c] : c };
+			if (i[0] >= nVertices || i[1] >= nVertices || i[2] >= nVertices) return;
+			const olc::vf2d vP[3] = { pPoints[i[0]], pPoints[i[1]], pPoints[i[2]] };
+			const olc::vf2d vT[3] = { pTex[i[0]], pTex[i[1]], pTex[i[2]] };
+			const olc::Pixel vC[3] = { pColour[i[0]], pColour[i[1]], pColour[i[2]] };
+			FillTexturedTriangle(vP, vT, vC, sprTex);
+		};
 
 		if (structure == olc::DecalStructure::LIST)
-		{			
-			for (size_t tri = 0; tri < vPoints.size() / 3; tri++)
-			{
-				std::vector<olc::vf2d> vP = { vPoints[tri * 3 + 0], vPoints[tri * 3 + 1], vPoints[tri * 3 + 2] };
-				std::vector<olc::vf2d> vT = { vTex[tri * 3 + 0], vTex[tri * 3 + 1], vTex[tri * 3 + 2] };
-				std::vector<olc::Pixel> vC = { vColour[tri * 3 + 0], vColour[tri * 3 + 1], vColour[tri * 3 + 2] };
-				FillTexturedTriangle(vP, vT, vC, sprTex);
-			}
+		{
+			for (size_t tri = 0; tri + 2 < nCount; tri += 3)
+				Triangle(tri, tri + 1, tri + 2);
 			return;
 		}
 
 		if (structure == olc::DecalStructure::STRIP)
 		{
-			for (size_t tri = 2; tri < vPoints.size(); tri++)
-			{
-				std::vector<olc::vf2d> vP = { vPoints[tri - 2], vPoints[tri-1], vPoints[tri] };
-				std::vector<olc::vf2d> vT = { vTex[tri - 2], vTex[tri - 1], vTex[tri] };
-				std::vector<olc::Pixel> vC = { vColour[tri - 2], vColour[tri - 1], vColour[tri] };
-				FillTexturedTriangle(vP, vT, vC, sprTex);
-			}
+			for (size_t tri = 2; tri < nCount; tri++)
+				Triangle(tri - 2, tri - 1, tri);
 			return;
 		}
 
 		if (structure == olc::DecalStructure::FAN)
 		{
-			for (size_t tri = 2; tri < vPoints.size(); tri++)
-			{
-				std::vector<olc::vf2d> vP = { vPoints[0], vPoints[tri - 1], vPoints[tri] };
-				std::vector<olc::vf2d> vT = { vTex[0], vTex[tri - 1], vTex[tri] };
-				std::vector<olc::Pixel> vC = { vColour[0], vColour[tri - 1], vColour[tri] };
-				FillTexturedTriangle(vP, vT, vC, sprTex);
-			}
+			for (size_t tri = 2; tri < nCount; tri++)
+				Triangle(0, tri - 1, tri);
 			return;
 		}
 	}
 
 
+	void PixelGameEngine::FillTexturedMesh(const std::vector<olc::vf2d>& vPoints, const std::vector<olc::vf2d>& vTex, const std::vector<olc::Pixel>& vColour, const std::vector<uint32_t>& vIndices, const std::vector<float>& vDepth, olc::Sprite* sprTex, bool bCullBackFaces)
+	{
+		const size_t nVertices = std::min({ vPoints.size(), vTex.size(), vColour.size() });
+		if (!vDepth.empty() && vDepth.size() < nVertices) return;
+		FillTexturedMesh(vPoints.data(), vTex.data(), vColour.data(), nVertices, vIndices.empty() ? nullptr : vIndices.data(), vIndices.size(),
+			vDepth.empty() ? nullptr : vDepth.data(), sprTex, bCullBackFaces);
+	}
+
+	void PixelGameEngine::FillTexturedMesh(const olc::vf2d* pPoints, const olc::vf2d* pTex, const olc::Pixel* pColour, size_t nVertices, const uint32_t* pIndices, size_t nIndices, const float* pDepth, olc::Sprite* sprTex, bool bCullBackFaces)
+	{
+		const size_t nCount = pIndices ? nIndices : nVertices;
+		for (size_t tri = 0; tri + 2 < nCount; tri += 3)
+		{
+			const size_t i[3] = { pIndices ? pIndices[tri] : tri, pIndices ? pIndices[tri + 1] : tri + 1, pIndices ? pIndices[tri + 2] : tri + 2 };
+			if (i[0] >= nVertices || i[1] >= nVertices || i[2] >= nVertices) continue;
+
+			const olc::vf2d vP[3] = { pPoints[i[0]], pPoints[i[1]], pPoints[i[2]] };
+			if (bCullBackFaces && (vP[1] - vP[0]).cross(vP[2] - vP[0]) <= 0.0f) continue;
+
+			const olc::vf2d vT[3] = { pTex[i[0]], pTex[i[1]], pTex[i[2]] };
+			const olc::Pixel vC[3] = { pColour[i[0]], pColour[i[1]], pColour[i[2]] };
+			if (pDepth != nullptr)
+			{
+				const float vZ[3] = { pDepth[i[0]], pDepth[i[1]], pDepth[i[2]] };
+				ShadeTriangle(vP, vT, vC, vZ, sprTex);
+			}
+			else
+				ShadeTriangle(vP, vT, vC, nullptr, sprTex);
+		}
+	}
+
 	void PixelGameEngine::DrawSprite(const olc::vi2d& pos, Sprite* sprite, uint32_t scale, uint8_t flip)
 	{ DrawSprite(pos.x, pos.y, sprite, scale, flip); }
 
@@ -3052,77 +4841,221 @@ namespace olc
 		if (sprite == nullptr)
 			return;
 
-		int32_t fxs = 0, fxm = 1, fx = 0;
-		int32_t fys = 0, fym = 1, fy = 0;
-		if (flip & olc::Sprite::Flip::HORIZ) { fxs = sprite->width - 1; fxm = -1; }
-		if (flip & olc::Sprite::Flip::VERT) { fys = sprite->height - 1; fym = -1; }
+		DrawPartialSprite(x, y, sprite, 0, 0, sprite->width, sprite->height, scale, flip);
+	}
+
+	void PixelGameEngine::DrawPartialSprite(const olc::vi2d& pos, Sprite* sprite, const olc::vi2d& sourcepos, const olc::vi2d& size, uint32_t scale, uint8_t flip)
+	{ DrawPartialSprite(pos.x, pos.y, sprite, sourcepos.x, sourcepos.y, size.x, size.y, scale, flip); }
+
+	void PixelGameEngine::DrawPartialSprite(int32_t x, int32_t y, Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip)
+	{
+		if (sprite == nullptr || pDrawTarget == nullptr || w <= 0 || h <= 0)
+			return;
+
+		const int32_t s = std::max(int32_t(scale), 1);
+		const bool bFlipX = flip & olc::Sprite::Flip::HORIZ;
+		const bool bFlipY = flip & olc::Sprite::Flip::VERT;
 
-		if (scale > 1)
+		// Clip the destination rectangle once, everything inside it is visible
+		const olc::vi2d vMin = ClipMin(), vMax = ClipMax();
+		const int32_t dx0 = std::max(x, vMin.x), dx1 = std::min(x + w * s, vMax.x);
+		const int32_t dy0 = std::max(y, vMin.y), dy1 = std::min(y + h * s, vMax.y);
+		if (dx0 >= dx1 || dy0 >= dy1)
+			return;
+		const int32_t nSpan = dx1 - dx0;
+		pDrawTarget->MarkDirty(dx0, dy0, nSpan, dy1 - dy0);
+
+		// Source region entirely within the sprite can be read directly, otherwise
+		// GetPixel() is used so the sprite's sample mode is respected
+		const bool bInside = ox >= 0 && oy >= 0 && ox + w <= sprite->width && oy + h <= sprite->height;
+		const bool bDirect = bInside && !bFlipX && s == 1;
+
+		DispatchPixelMode([&](const auto& mode)
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < sprite->width; i++, fx += fxm)
+			int32_t nExpanded = -1;
+			for (int32_t dy = dy0; dy < dy1; dy++)
 			{
-				fy = fys;
-				for (int32_t j = 0; j < sprite->height; j++, fy += fym)
-					for (uint32_t is = 0; is < scale; is++)
-						for (uint32_t js = 0; js < scale; js++)
-							Draw(x + (i * scale) + is, y + (j * scale) + js, sprite->GetPixel(fx, fy));
+				const int32_t j = (dy - y) / s;
+				const int32_t sy = oy + (bFlipY ? h - 1 - j : j);
+				if (bDirect)
+				{
+					DrawSpan(mode, dx0, dy, nSpan, sprite->pColData.data() + size_t(sy) * size_t(sprite->width) + ox + (dx0 - x));
+					continue;
+				}
+
+				// Expand (flip and scale) the visible part of the source row once,
+				// then reuse it for each replicated destination row
+				if (j != nExpanded)
+				{
+					vSpanBuffer.resize(size_t(nSpan));
+					int32_t i = (dx0 - x) / s;
+					int32_t nRepeat = s - (dx0 - x) % s;
+					for (int32_t n = 0; n < nSpan; i++, nRepeat = s)
+					{
+						const int32_t sx = ox + (bFlipX ? w - 1 - i : i);
+						const Pixel p = bInside ? sprite->pColData.data()[size_t(sy) * size_t(sprite->width) + sx] : sprite->GetPixel(sx, sy);
+						const int32_t k = std::min(nRepeat, nSpan - n);
+						std::fill_n(vSpanBuffer.begin() + n, k, p);
+						n += k;
+					}
+					nExpanded = j;
+				}
+
+				DrawSpan(mode, dx0, dy, nSpan, vSpanBuffer.data());
 			}
-		}
-		else
+		});
+	}
+
+	void PixelGameEngine::SetDecalMode(const olc::DecalMode& mode)
+	{ nDecalMode = mode; }
+
+	void PixelGameEngine::SetDecalStructure(const olc::DecalStructure& structure)
+	{ nDecalStructure = structure; }
+
+	void PixelGameEngine::SetDecalSortKey(const float fKey)
+	{ fDecalSortKey = std::isnan(fKey) ? 0.0f : fKey; }
+
+	olc::DecalInstance DecalVertexArena::Allocate(const uint32_t nPoints)
+	{
+		const size_t nOffset = pos.size();
+		pos.resize(nOffset + nPoints);
+		uv.resize(nOffset + nPoints);
+		w.resize(nOffset + nPoints, 1.0f);
+		z.resize(nOffset + nPoints, 1.0f);
+		tint.resize(nOffset + nPoints, olc::WHITE);
+
+		olc::DecalInstance di;
+		di.offset = uint32_t(nOffset);
+		di.points = nPoints;
+		Bind(di);
+		return di;
+	}
+
+	olc::DecalInstance DecalVertexArena::AllocateInstances(const uint32_t nInstances)
+	{
+		olc::DecalInstance di = Allocate(0);
+		di.instanceOffset = uint32_t(quads.size());
+		di.instanceCount = nInstances;
+		quads.resize(quads.size() + nInstances);
+		Bind(di);
+		return di;
+	}
+
+	void DecalVertexArena::Release(const olc::DecalInstance& di)
+	{
+		pos.resize(di.offset); uv.resize(di.offset); w.resize(di.offset); z.resize(di.offset); tint.resize(di.offset);
+		quads.resize(di.instanceOffset);
+	}
+
+	const olc::DecalInstance& DecalVertexArena::Bind(olc::DecalInstance& di)
+	{
+		di.pos = pos.data() + di.offset;
+		di.uv = uv.data() + di.offset;
+		di.w = w.data() + di.offset;
+		di.z = z.data() + di.offset;
+		di.tint = tint.data() + di.offset;
+		di.instances = quads.data() + di.instanceOffset;
+		return di;
+	}
+
+	void DecalVertexArena::Clear()
+	{
+		pos.clear(); uv.clear(); w.clear(); z.clear(); tint.clear(); quads.clear();
+	}
+
+	void Renderer::DrawDecalInstanced(const olc::DecalInstance& decal)
+	{
+		std::array<olc::vf2d, 4> pos, uv;
+		std::array<float, 4> w = { { 1.0f, 1.0f, 1.0f, 1.0f } };
+		std::array<olc::Pixel, 4> tint;
+
+		olc::DecalInstance di;
+		di.decal = decal.decal;
+		di.mode = decal.mode;
+		di.structure = olc::DecalStructure::FAN;
+		di.points = 4;
+		di.pos = pos.data(); di.uv = uv.data(); di.w = w.data(); di.z = w.data(); di.tint = tint.data();
+
+		for (uint32_t i = 0; i < decal.instanceCount; i++)
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < sprite->width; i++, fx += fxm)
-			{
-				fy = fys;
-				for (int32_t j = 0; j < sprite->height; j++, fy += fym)
-					Draw(x + i, y + j, sprite->GetPixel(fx, fy));
-			}
+			const olc::DecalQuad& q = decal.instances[i];
+			pos[0] = q.origin; pos[1] = q.origin + q.axisY; pos[2] = q.origin + q.axisX + q.axisY; pos[3] = q.origin + q.axisX;
+			uv[0] = { q.uvtl.x, q.uvtl.y }; uv[1] = { q.uvtl.x, q.uvbr.y }; uv[2] = { q.uvbr.x, q.uvbr.y }; uv[3] = { q.uvbr.x, q.uvtl.y };
+			tint.fill(q.tint);
+			DrawDecal(di);
 		}
 	}
 
-	void PixelGameEngine::DrawPartialSprite(const olc::vi2d& pos, Sprite* sprite, const olc::vi2d& sourcepos, const olc::vi2d& size, uint32_t scale, uint8_t flip)
-	{ DrawPartialSprite(pos.x, pos.y, sprite, sourcepos.x, sourcepos.y, size.x, size.y, scale, flip); }
+	olc::DecalInstance PixelGameEngine::AllocateDecal(olc::Decal* decal, const uint32_t nPoints)
+	{
+		olc::DecalInstance di = vLayers[nTargetLayer].decalArena.Allocate(nPoints);
+		di.decal = decal;
+		di.mode = nDecalMode;
+		di.structure = nDecalStructure;
+		return di;
+	}
 
-	void PixelGameEngine::DrawPartialSprite(int32_t x, int32_t y, Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip)
+	void PixelGameEngine::SubmitDecal(olc::DecalInstance& di)
 	{
-		if (sprite == nullptr)
-			return;
+		// Decals are already in normalised device coordinates, where the view,
+		// as set by the viewport or adv_HardwareClip(), spans -1 to 1 on both axes.
+		// The clip rectangle, mapped the same way, narrows that further
+		if (!vClipStack.empty())
+		{
+			const olc::vf2d vLo = olc::vf2d(vClipMin) * vInvScreenSize * 2.0f - olc::vf2d(1.0f, 1.0f);
+			const olc::vf2d vHi = olc::vf2d(vClipMax) * vInvScreenSize * 2.0f - olc::vf2d(1.0f, 1.0f);
+			di.clipMin = { vLo.x, -vHi.y };
+			di.clipMax = { vHi.x, -vLo.y };
+		}
 
-		int32_t fxs = 0, fxm = 1, fx = 0;
-		int32_t fys = 0, fym = 1, fy = 0;
-		if (flip & olc::Sprite::Flip::HORIZ) { fxs = w - 1; fxm = -1; }
-		if (flip & olc::Sprite::Flip::VERT) { fys = h - 1; fym = -1; }
+		auto OnScreen = [&di](const olc::vf2d* p, const uint32_t n)
+		{
+			olc::vf2d vMin = p[0], vMax = p[0];
+			for (uint32_t i = 1; i < n; i++) { vMin = vMin.min(p[i]); vMax = vMax.max(p[i]); }
+			return !(vMax.x < di.clipMin.x || vMin.x > di.clipMax.x || vMax.y < di.clipMin.y || vMin.y > di.clipMax.y);
+		};
 
-		if (scale > 1)
+		auto& layer = vLayers[nTargetLayer];
+		di.key = fDecalSortKey;
+		di.order = uint32_t(layer.vecDecalInstance.size());
+		if (nTargetLayer >= statsFrame.vLayers.size()) statsFrame.vLayers.resize(size_t(nTargetLayer) + 1);
+		auto& stats = statsFrame.vLayers[nTargetLayer];
+		if (di.instanceCount > 0)
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < w; i++, fx += fxm)
+			// Only the copies that can be seen are kept
+			uint32_t nKept = 0;
+			for (uint32_t i = 0; i < di.instanceCount; i++)
 			{
-				fy = fys;
-				for (int32_t j = 0; j < h; j++, fy += fym)
-					for (uint32_t is = 0; is < scale; is++)
-						for (uint32_t js = 0; js < scale; js++)
-							Draw(x + (i * scale) + is, y + (j * scale) + js, sprite->GetPixel(fx + ox, fy + oy));
+				const olc::DecalQuad& q = di.instances[i];
+				const olc::vf2d vCorner[4] = { q.origin, q.origin + q.axisX, q.origin + q.axisY, q.origin + q.axisX + q.axisY };
+				if (OnScreen(vCorner, 4)) di.instances[nKept++] = q;
 			}
+			nDecalsCulled += di.instanceCount - nKept;
+			stats.nDecals += nKept;
+			stats.nVertices += uint64_t(nKept) * 4;
+			di.instanceCount = nKept;
+			layer.decalArena.quads.resize(di.instanceOffset + nKept);
+			if (nKept > 0) layer.vecDecalInstance.push_back(di);
+		}
+		else if (di.points == 0 || di.depth || OnScreen(di.pos, di.points))
+		{
+			stats.nDecals++;
+			stats.nVertices += di.points;
+			layer.vecDecalInstance.push_back(di);
 		}
 		else
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < w; i++, fx += fxm)
-			{
-				fy = fys;
-				for (int32_t j = 0; j < h; j++, fy += fym)
-					Draw(x + i, y + j, sprite->GetPixel(fx + ox, fy + oy));
-			}
+			nDecalsCulled++;
+			layer.decalArena.Release(di);
 		}
 	}
 
-	void PixelGameEngine::SetDecalMode(const olc::DecalMode& mode)
-	{ nDecalMode = mode; }
-
-	void PixelGameEngine::SetDecalStructure(const olc::DecalStructure& structure)
-	{ nDecalStructure = structure; }
+	void PixelGameEngine::SetDecalUV(olc::DecalInstance& di, const olc::Decal* decal) const
+	{
+		const olc::vf2d uvtl = decal->vUVOffset;
+		const olc::vf2d uvbr = decal->vUVOffset + decal->vUVSize;
+		di.uv[0] = { uvtl.x, uvtl.y }; di.uv[1] = { uvtl.x, uvbr.y }; di.uv[2] = { uvbr.x, uvbr.y }; di.uv[3] = { uvbr.x, uvtl.y };
+	}
 
 	void PixelGameEngine::DrawPartialDecal(const olc::vf2d& pos, olc::Decal* decal, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::vf2d& scale, const olc::Pixel& tint)
 	{
@@ -3143,18 +5076,14 @@ namespace olc
 		olc::vf2d vQuantisedPos = ((vScreenSpacePos * vWindow) + olc::vf2d(0.5f, 0.5f)).floor() / vWindow;
 		olc::vf2d vQuantisedDim = ((vScreenSpaceDim * vWindow) + olc::vf2d(0.5f, -0.5f)).ceil() / vWindow;
 
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vQuantisedPos.x, vQuantisedPos.y }, { vQuantisedPos.x, vQuantisedDim.y }, { vQuantisedDim.x, vQuantisedDim.y }, { vQuantisedDim.x, vQuantisedPos.y } };
-		olc::vf2d uvtl = (source_pos + olc::vf2d(0.0001f, 0.0001f)) * decal->vUVScale;
-		olc::vf2d uvbr = (source_pos + source_size - olc::vf2d(0.0001f, 0.0001f)) * decal->vUVScale;
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
-		di.w = { 1,1,1,1 };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DecalInstance di = AllocateDecal(decal, 4);
+		std::fill_n(di.tint, 4, tint);
+		di.pos[0] = { vQuantisedPos.x, vQuantisedPos.y }; di.pos[1] = { vQuantisedPos.x, vQuantisedDim.y };
+		di.pos[2] = { vQuantisedDim.x, vQuantisedDim.y }; di.pos[3] = { vQuantisedDim.x, vQuantisedPos.y };
+		olc::vf2d uvtl = (source_pos + olc::vf2d(0.0001f, 0.0001f)) * decal->vUVScale + decal->vUVOffset;
+		olc::vf2d uvbr = (source_pos + source_size - olc::vf2d(0.0001f, 0.0001f)) * decal->vUVScale + decal->vUVOffset;
+		di.uv[0] = { uvtl.x, uvtl.y }; di.uv[1] = { uvtl.x, uvbr.y }; di.uv[2] = { uvbr.x, uvbr.y }; di.uv[3] = { uvbr.x, uvtl.y };
+		SubmitDecal(di);
 	}
 
 	void PixelGameEngine::DrawPartialDecal(const olc::vf2d& pos, const olc::vf2d& size, olc::Decal* decal, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::Pixel& tint)
@@ -3171,18 +5100,14 @@ namespace olc
 			vScreenSpacePos.y - (2.0f * size.y * vInvScreenSize.y)
 		};
 
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
-		olc::vf2d uvtl = (source_pos) * decal->vUVScale;
+		DecalInstance di = AllocateDecal(decal, 4);
+		std::fill_n(di.tint, 4, tint);
+		di.pos[0] = { vScreenSpacePos.x, vScreenSpacePos.y }; di.pos[1] = { vScreenSpacePos.x, vScreenSpaceDim.y };
+		di.pos[2] = { vScreenSpaceDim.x, vScreenSpaceDim.y }; di.pos[3] = { vScreenSpaceDim.x, vScreenSpacePos.y };
+		olc::vf2d uvtl = (source_pos) * decal->vUVScale + decal->vUVOffset;
 		olc::vf2d uvbr = uvtl + ((source_size) * decal->vUVScale);
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
-		di.w = { 1,1,1,1 };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		di.uv[0] = { uvtl.x, uvtl.y }; di.uv[1] = { uvtl.x, uvbr.y }; di.uv[2] = { uvbr.x, uvbr.y }; di.uv[3] = { uvbr.x, uvtl.y };
+		SubmitDecal(di);
 	}
 
 
@@ -3196,103 +5121,70 @@ namespace olc
 
 		olc::vf2d vScreenSpaceDim =
 		{
-			vScreenSpacePos.x + (2.0f * (float(decal->sprite->width) * vInvScreenSize.x)) * scale.x,
-			vScreenSpacePos.y - (2.0f * (float(decal->sprite->height) * vInvScreenSize.y)) * scale.y
+			vScreenSpacePos.x + (2.0f * (float(decal->vSize.x) * vInvScreenSize.x)) * scale.x,
+			vScreenSpacePos.y - (2.0f * (float(decal->vSize.y) * vInvScreenSize.y)) * scale.y
 		};
 
-		DecalInstance di;
-		di.decal = decal;
-		di.points = 4;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
-		di.w = { 1, 1, 1, 1 };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DecalInstance di = AllocateDecal(decal, 4);
+		std::fill_n(di.tint, 4, tint);
+		di.pos[0] = { vScreenSpacePos.x, vScreenSpacePos.y }; di.pos[1] = { vScreenSpacePos.x, vScreenSpaceDim.y };
+		di.pos[2] = { vScreenSpaceDim.x, vScreenSpaceDim.y }; di.pos[3] = { vScreenSpaceDim.x, vScreenSpacePos.y };
+		SetDecalUV(di, decal);
+		SubmitDecal(di);
 	}
 
 	void PixelGameEngine::DrawExplicitDecal(olc::Decal* decal, const olc::vf2d* pos, const olc::vf2d* uv, const olc::Pixel* col, uint32_t elements)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.pos.resize(elements);
-		di.uv.resize(elements);
-		di.w.resize(elements);
-		di.tint.resize(elements);
-		di.points = elements;
+		DecalInstance di = AllocateDecal(decal, elements);
 		for (uint32_t i = 0; i < elements; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 			di.uv[i] = uv[i];
 			di.tint[i] = col[i];
-			di.w[i] = 1.0f;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		SubmitDecal(di);
 	}
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const olc::Pixel tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
+		DecalInstance di = AllocateDecal(decal, uint32_t(pos.size()));
 		for (uint32_t i = 0; i < di.points; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 			di.uv[i] = uv[i];
 			di.tint[i] = tint;
-			di.w[i] = 1.0f;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		SubmitDecal(di);
 	}
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel> &tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
+		DecalInstance di = AllocateDecal(decal, uint32_t(pos.size()));
 		for (uint32_t i = 0; i < di.points; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 			di.uv[i] = uv[i];
 			di.tint[i] = tint[i];
-			di.w[i] = 1.0f;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		SubmitDecal(di);
 	}
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& colours, const olc::Pixel tint)
 	{
-		std::vector<olc::Pixel> newColours(colours.size(), olc::WHITE);
-		std::transform(colours.begin(), colours.end(), newColours.begin(),
-			[&tint](const olc::Pixel pin) {	return pin * tint; });
-		DrawPolygonDecal(decal, pos, uv, newColours);
+		DecalInstance di = AllocateDecal(decal, uint32_t(pos.size()));
+		for (uint32_t i = 0; i < di.points; i++)
+		{
+			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
+			di.uv[i] = uv[i];
+			di.tint[i] = colours[i] * tint;
+		}
+		SubmitDecal(di);
 	}
 
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<float>& depth, const std::vector<olc::vf2d>& uv, const olc::Pixel tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
+		DecalInstance di = AllocateDecal(decal, uint32_t(pos.size()));
 		for (uint32_t i = 0; i < di.points; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
@@ -3300,20 +5192,12 @@ namespace olc
 			di.tint[i] = tint;
 			di.w[i] = depth[i];
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		SubmitDecal(di);
 	}
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<float>& depth, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& colours, const olc::Pixel tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
+		DecalInstance di = AllocateDecal(decal, uint32_t(pos.size()));
 		for (uint32_t i = 0; i < di.points; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
@@ -3321,23 +5205,14 @@ namespace olc
 			di.tint[i] = colours[i] * tint;
 			di.w[i] = depth[i];
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		SubmitDecal(di);
 	}
 
 #ifdef OLC_ENABLE_EXPERIMENTAL
 	// Lightweight 3D
 	void PixelGameEngine::LW3D_DrawTriangles(olc::Decal* decal, const std::vector<std::array<float, 3>>& pos, const std::vector<olc::vf2d>& tex, const std::vector<olc::Pixel>& col)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.z.resize(di.points);
-		di.tint.resize(di.points);
+		DecalInstance di = AllocateDecal(decal, uint32_t(pos.size()));
 		for (uint32_t i = 0; i < di.points; i++)
 		{
 			di.pos[i] = { pos[i][0], pos[i][1] };
@@ -3346,28 +5221,22 @@ namespace olc
 			di.uv[i] = tex[i];
 			di.tint[i] = col[i];			
 		}
-		di.mode = nDecalMode;
 		di.structure = DecalStructure::LIST;
 		di.depth = true;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		SubmitDecal(di);
 	}
 
 	void PixelGameEngine::LW3D_DrawWarpedDecal(olc::Decal* decal, const std::vector<std::array<float, 3>>& pos, const olc::Pixel& tint)
 	{
 		// Thanks Nathan Reed, a brilliant article explaining whats going on here
 		// http://www.reedbeta.com/blog/quadrilateral-interpolation-part-1/
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.w = { 1, 1, 1, 1 };
-		di.z = { 1, 1, 1, 1 };
-		di.pos.resize(4);
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
 		olc::vf2d center;
 		float rd = ((pos[2][0] - pos[0][0]) * (pos[3][1] - pos[1][1]) - (pos[3][0] - pos[1][0]) * (pos[2][1] - pos[0][1]));
 		if (rd != 0)
 		{
+			DecalInstance di = AllocateDecal(decal, 4);
+			std::fill_n(di.tint, 4, tint);
+			SetDecalUV(di, decal);
 			rd = 1.0f / rd;
 			float rn = ((pos[3][0] - pos[1][0]) * (pos[0][1] - pos[1][1]) - (pos[3][1] - pos[1][1]) * (pos[0][0] - pos[1][0])) * rd;
 			float sn = ((pos[2][0] - pos[0][0]) * (pos[0][1] - pos[1][1]) - (pos[2][1] - pos[0][1]) * (pos[0][0] - pos[1][0])) * rd;
@@ -3388,10 +5257,8 @@ namespace olc
 				di.z[i] = pos[i][2];
 				di.pos[i] = { (pos[i][0] * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i][1] * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 			}
-			di.mode = nDecalMode;
-			di.structure = nDecalStructure;
 			di.depth = true;
-			vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+			SubmitDecal(di);
 		}
 	}
 #endif
@@ -3400,7 +5267,10 @@ namespace olc
 	{
 		auto m = nDecalMode;
 		nDecalMode = olc::DecalMode::WIREFRAME;
-		DrawPolygonDecal(nullptr, { pos1, pos2 }, { {0, 0}, {0,0} }, p);
+		std::array<olc::vf2d, 2> points = { { pos1, pos2 } };
+		std::array<olc::vf2d, 2> uvs = { {{0,0},{0,0}} };
+		std::array<olc::Pixel, 2> cols = { {p, p} };
+		DrawExplicitDecal(nullptr, points.data(), uvs.data(), cols.data(), 2);
 		nDecalMode = m;
 
 		/*DecalInstance di;
@@ -3471,39 +5341,28 @@ namespace olc
 
 	void PixelGameEngine::DrawRotatedDecal(const olc::vf2d& pos, olc::Decal* decal, const float fAngle, const olc::vf2d& center, const olc::vf2d& scale, const olc::Pixel& tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.pos.resize(4);
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
-		di.w = { 1, 1, 1, 1 };
-		di.tint = { tint, tint, tint, tint };
-		di.points = 4;
+		DecalInstance di = AllocateDecal(decal, 4);
+		SetDecalUV(di, decal);
+		std::fill_n(di.tint, 4, tint);
 		di.pos[0] = (olc::vf2d(0.0f, 0.0f) - center) * scale;
-		di.pos[1] = (olc::vf2d(0.0f, float(decal->sprite->height)) - center) * scale;
-		di.pos[2] = (olc::vf2d(float(decal->sprite->width), float(decal->sprite->height)) - center) * scale;
-		di.pos[3] = (olc::vf2d(float(decal->sprite->width), 0.0f) - center) * scale;
+		di.pos[1] = (olc::vf2d(0.0f, float(decal->vSize.y)) - center) * scale;
+		di.pos[2] = (olc::vf2d(float(decal->vSize.x), float(decal->vSize.y)) - center) * scale;
+		di.pos[3] = (olc::vf2d(float(decal->vSize.x), 0.0f) - center) * scale;
 		float c = cos(fAngle), s = sin(fAngle);
 		for (int i = 0; i < 4; i++)
 		{
 			di.pos[i] = pos + olc::vf2d(di.pos[i].x * c - di.pos[i].y * s, di.pos[i].x * s + di.pos[i].y * c);
 			di.pos[i] = di.pos[i] * vInvScreenSize * 2.0f - olc::vf2d(1.0f, 1.0f);
 			di.pos[i].y *= -1.0f;
-			di.w[i] = 1;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		SubmitDecal(di);
 	}
 
 
 	void PixelGameEngine::DrawPartialRotatedDecal(const olc::vf2d& pos, olc::Decal* decal, const float fAngle, const olc::vf2d& center, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::vf2d& scale, const olc::Pixel& tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = 4;
-		di.tint = { tint, tint, tint, tint };
-		di.w = { 1, 1, 1, 1 };
-		di.pos.resize(4);
+		DecalInstance di = AllocateDecal(decal, 4);
+		std::fill_n(di.tint, 4, tint);
 		di.pos[0] = (olc::vf2d(0.0f, 0.0f) - center) * scale;
 		di.pos[1] = (olc::vf2d(0.0f, source_size.y) - center) * scale;
 		di.pos[2] = (olc::vf2d(source_size.x, source_size.y) - center) * scale;
@@ -3516,30 +5375,59 @@ namespace olc
 			di.pos[i].y *= -1.0f;
 		}
 
-		olc::vf2d uvtl = source_pos * decal->vUVScale;
+		olc::vf2d uvtl = source_pos * decal->vUVScale + decal->vUVOffset;
 		olc::vf2d uvbr = uvtl + (source_size * decal->vUVScale);
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
+		di.uv[0] = { uvtl.x, uvtl.y }; di.uv[1] = { uvtl.x, uvbr.y }; di.uv[2] = { uvbr.x, uvbr.y }; di.uv[3] = { uvbr.x, uvtl.y };
+		SubmitDecal(di);
+	}
+
+	void PixelGameEngine::DrawDecalInstanced(olc::Decal* decal, const olc::DecalInstanceDesc* pInstances, size_t nInstances)
+	{
+		if (decal == nullptr || nInstances == 0) return;
+
+		DecalInstance di = vLayers[nTargetLayer].decalArena.AllocateInstances(uint32_t(nInstances));
+		di.decal = decal;
 		di.mode = nDecalMode;
 		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+
+		// Screen pixels to normalised device coordinates, y pointing up
+		const olc::vf2d vNDC = vInvScreenSize * olc::vf2d(2.0f, -2.0f);
+		for (size_t i = 0; i < nInstances; i++)
+		{
+			const olc::DecalInstanceDesc& inst = pInstances[i];
+			const bool bWhole = inst.source_size.x == 0.0f || inst.source_size.y == 0.0f;
+			const olc::vf2d vSize = (bWhole ? olc::vf2d(decal->vSize) : inst.source_size) * inst.scale;
+			const float c = inst.angle == 0.0f ? 1.0f : std::cos(inst.angle);
+			const float s = inst.angle == 0.0f ? 0.0f : std::sin(inst.angle);
+
+			const olc::vf2d o = -inst.center * inst.scale;
+			const olc::vf2d p = inst.pos + olc::vf2d(o.x * c - o.y * s, o.x * s + o.y * c);
+
+			olc::DecalQuad& q = di.instances[i];
+			q.origin = { p.x * vNDC.x - 1.0f, p.y * vNDC.y + 1.0f };
+			q.axisX = olc::vf2d(vSize.x * c, vSize.x * s) * vNDC;
+			q.axisY = olc::vf2d(-vSize.y * s, vSize.y * c) * vNDC;
+			q.uvtl = bWhole ? decal->vUVOffset : inst.source_pos * decal->vUVScale + decal->vUVOffset;
+			q.uvbr = bWhole ? decal->vUVOffset + decal->vUVSize : q.uvtl + inst.source_size * decal->vUVScale;
+			q.tint = inst.tint;
+		}
+		SubmitDecal(di);
 	}
 
+	void PixelGameEngine::DrawDecalInstanced(olc::Decal* decal, const std::vector<olc::DecalInstanceDesc>& vInstances)
+	{ DrawDecalInstanced(decal, vInstances.data(), vInstances.size()); }
+
 	void PixelGameEngine::DrawPartialWarpedDecal(olc::Decal* decal, const olc::vf2d* pos, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::Pixel& tint)
 	{
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.w = { 1, 1, 1, 1 };
-		di.pos.resize(4);
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
 		olc::vf2d center;
 		float rd = ((pos[2].x - pos[0].x) * (pos[3].y - pos[1].y) - (pos[3].x - pos[1].x) * (pos[2].y - pos[0].y));
 		if (rd != 0)
 		{
-			olc::vf2d uvtl = source_pos * decal->vUVScale;
+			DecalInstance di = AllocateDecal(decal, 4);
+			std::fill_n(di.tint, 4, tint);
+			olc::vf2d uvtl = source_pos * decal->vUVScale + decal->vUVOffset;
 			olc::vf2d uvbr = uvtl + (source_size * decal->vUVScale);
-			di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
+			di.uv[0] = { uvtl.x, uvtl.y }; di.uv[1] = { uvtl.x, uvbr.y }; di.uv[2] = { uvbr.x, uvbr.y }; di.uv[3] = { uvbr.x, uvtl.y };
 
 			rd = 1.0f / rd;
 			float rn = ((pos[3].x - pos[1].x) * (pos[0].y - pos[1].y) - (pos[3].y - pos[1].y) * (pos[0].x - pos[1].x)) * rd;
@@ -3552,9 +5440,7 @@ namespace olc
 				di.uv[i] *= q; di.w[i] *= q;
 				di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 			}
-			di.mode = nDecalMode;
-			di.structure = nDecalStructure;
-			vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+			SubmitDecal(di);
 		}
 	}
 
@@ -3562,17 +5448,13 @@ namespace olc
 	{
 		// Thanks Nathan Reed, a brilliant article explaining whats going on here
 		// http://www.reedbeta.com/blog/quadrilateral-interpolation-part-1/
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.w = { 1, 1, 1, 1 };
-		di.pos.resize(4);
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
 		olc::vf2d center;
 		float rd = ((pos[2].x - pos[0].x) * (pos[3].y - pos[1].y) - (pos[3].x - pos[1].x) * (pos[2].y - pos[0].y));
 		if (rd != 0)
 		{
+			DecalInstance di = AllocateDecal(decal, 4);
+			std::fill_n(di.tint, 4, tint);
+			SetDecalUV(di, decal);
 			rd = 1.0f / rd;
 			float rn = ((pos[3].x - pos[1].x) * (pos[0].y - pos[1].y) - (pos[3].y - pos[1].y) * (pos[0].x - pos[1].x)) * rd;
 			float sn = ((pos[2].x - pos[0].x) * (pos[0].y - pos[1].y) - (pos[2].y - pos[0].y) * (pos[0].x - pos[1].x)) * rd;
@@ -3584,9 +5466,7 @@ namespace olc
 				di.uv[i] *= q; di.w[i] *= q;
 				di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 			}
-			di.mode = nDecalMode;
-			di.structure = nDecalStructure;
-			vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+			SubmitDecal(di);
 		}
 	}
 
@@ -3717,46 +5597,38 @@ namespace olc
 		int32_t sx = 0;
 		int32_t sy = 0;
 		Pixel::Mode m = nPixelMode;
+		if (pDrawTarget)
+		{
+			olc::vi2d vSize = GetTextSize(sText) * int32_t(scale);
+			pDrawTarget->MarkDirty(x, y, vSize.x, vSize.y);
+		}
 		// Thanks @tucna, spotted bug with col.ALPHA :P
 		if (m != Pixel::CUSTOM) // Thanks @Megarev, required for "shaders"
 		{
 			if (col.a != 255)		SetPixelMode(Pixel::ALPHA);
 			else					SetPixelMode(Pixel::MASK);
 		}
-		for (auto c : sText)
+		DispatchPixelMode([&](const auto& mode)
 		{
-			if (c == '\n')
-			{
-				sx = 0; sy += 8 * scale;
-			}
-			else if (c == '\t')
-			{
-				sx += 8 * nTabSizeInSpaces * scale;
-			}
-			else			
+			for (auto c : sText)
 			{
-				int32_t ox = (c - 32) % 16;
-				int32_t oy = (c - 32) / 16;
-
-				if (scale > 1)
+				if (c == '\n')
 				{
-					for (uint32_t i = 0; i < 8; i++)
-						for (uint32_t j = 0; j < 8; j++)
-							if (fontRenderable.Sprite()->GetPixel(i + ox * 8, j + oy * 8).r > 0)
-								for (uint32_t is = 0; is < scale; is++)
-									for (uint32_t js = 0; js < scale; js++)
-										Draw(x + sx + (i * scale) + is, y + sy + (j * scale) + js, col);
+					sx = 0; sy += 8 * scale;
+				}
+				else if (c == '\t')
+				{
+					sx += 8 * nTabSizeInSpaces * scale;
 				}
 				else
 				{
-					for (uint32_t i = 0; i < 8; i++)
-						for (uint32_t j = 0; j < 8; j++)
-							if (fontRenderable.Sprite()->GetPixel(i + ox * 8, j + oy * 8).r > 0)
-								Draw(x + sx + i, y + sy + j, col);
+					uint32_t g = uint32_t(uint8_t(c)) - 32;
+					if (g < 96 && vFontMask[g] != 0)
+						DrawGlyph(mode, x + sx, y + sy, vFontMask[g], col, int32_t(scale));
+					sx += 8 * scale;
 				}
-				sx += 8 * scale;
 			}
-		}
+		});
 		SetPixelMode(m);
 	}
 
@@ -3785,46 +5657,39 @@ namespace olc
 		int32_t sx = 0;
 		int32_t sy = 0;
 		Pixel::Mode m = nPixelMode;
+		if (pDrawTarget)
+		{
+			olc::vi2d vSize = GetTextSizeProp(sText) * int32_t(scale);
+			pDrawTarget->MarkDirty(x, y, vSize.x, vSize.y);
+		}
 
 		if (m != Pixel::CUSTOM)
 		{
 			if (col.a != 255)		SetPixelMode(Pixel::ALPHA);
 			else					SetPixelMode(Pixel::MASK);
 		}
-		for (auto c : sText)
+		DispatchPixelMode([&](const auto& mode)
 		{
-			if (c == '\n')
-			{
-				sx = 0; sy += 8 * scale;
-			}
-			else if (c == '\t')
-			{
-				sx += 8 * nTabSizeInSpaces * scale;
-			}
-			else
+			for (auto c : sText)
 			{
-				int32_t ox = (c - 32) % 16;
-				int32_t oy = (c - 32) / 16;
-
-				if (scale > 1)
+				if (c == '\n')
+				{
+					sx = 0; sy += 8 * scale;
+				}
+				else if (c == '\t')
 				{
-					for (int32_t i = 0; i < vFontSpacing[c - 32].y; i++)
-						for (int32_t j = 0; j < 8; j++)
-							if (fontRenderable.Sprite()->GetPixel(i + ox * 8 + vFontSpacing[c - 32].x, j + oy * 8).r > 0)
-								for (int32_t is = 0; is < int(scale); is++)
-									for (int32_t js = 0; js < int(scale); js++)
-										Draw(x + sx + (i * scale) + is, y + sy + (j * scale) + js, col);
+					sx += 8 * nTabSizeInSpaces * scale;
 				}
 				else
 				{
-					for (int32_t i = 0; i < vFontSpacing[c - 32].y; i++)
-						for (int32_t j = 0; j < 8; j++)
-							if (fontRenderable.Sprite()->GetPixel(i + ox * 8 + vFontSpacing[c - 32].x, j + oy * 8).r > 0)
-								Draw(x + sx + i, y + sy + j, col);
+					uint32_t g = uint32_t(uint8_t(c)) - 32;
+					if (g >= 96) continue;
+					if (vFontMaskProp[g] != 0)
+						DrawGlyph(mode, x + sx, y + sy, vFontMaskProp[g], col, int32_t(scale));
+					sx += vFontSpacing[g].y * scale;
 				}
-				sx += vFontSpacing[c - 32].y * scale;
 			}
-		}
+		});
 		SetPixelMode(m);
 	}
 
@@ -3837,7 +5702,16 @@ namespace olc
 	void PixelGameEngine::SetPixelMode(std::function<olc::Pixel(const int x, const int y, const olc::Pixel&, const olc::Pixel&)> pixelMode)
 	{
 		funcPixelMode = pixelMode;
+		funcPixelModeSpan = nullptr;
 		nPixelMode = Pixel::Mode::CUSTOM;
+		nCustomModeVersion++;
+	}
+
+	void PixelGameEngine::SetPixelModeSpan(std::function<void(const int x, const int y, const int32_t count, const olc::Pixel*, olc::Pixel*)> pixelMode)
+	{
+		funcPixelModeSpan = pixelMode;
+		nPixelMode = Pixel::Mode::CUSTOM;
+		nCustomModeVersion++;
 	}
 
 	void PixelGameEngine::SetPixelBlend(float fBlend)
@@ -4129,6 +6003,7 @@ namespace olc
 	void PixelGameEngine::olc_UpdateWindowSize(int32_t x, int32_t y)
 	{
 		vWindowSize = { x, y };
+		SignalIdle();
 
 		if (bRealWindowMode)
 		{
@@ -4140,10 +6015,12 @@ namespace olc
 	}
 
 	void PixelGameEngine::olc_UpdateMouseWheel(int32_t delta)
-	{ nMouseWheelDeltaCache += delta; }
+	{ nMouseWheelDeltaCache += delta; SignalIdle(); }
 
 	void PixelGameEngine::olc_UpdateMouse(int32_t x, int32_t y)
 	{
+		SignalIdle();
+
 		// Mouse coords come in screen space
 		// But leave in pixel space
 		bHasMouseFocus = true;
@@ -4160,19 +6037,20 @@ namespace olc
 	}
 
 	void PixelGameEngine::olc_UpdateMouseState(int32_t button, bool state)
-	{ pMouseNewState[button] = state; }
+	{ pMouseNewState[button] = state; SignalIdle(); }
 
 	void PixelGameEngine::olc_UpdateKeyState(int32_t key, bool state)
-	{ pKeyNewState[key] = state; }
+	{ pKeyNewState[key] = state; SignalIdle(); }
 
 	void PixelGameEngine::olc_UpdateMouseFocus(bool state)
-	{ bHasMouseFocus = state; }
+	{ bHasMouseFocus = state; SignalIdle(); }
 
 	void PixelGameEngine::olc_UpdateKeyFocus(bool state)
-	{ bHasInputFocus = state; }
+	{ bHasInputFocus = state; SignalIdle(); }
 
 	void PixelGameEngine::olc_DropFiles(int32_t x, int32_t y, const std::vector<std::string>& vFiles)
 	{ 
+		SignalIdle();
 		x -= vViewPos.x;
 		y -= vViewPos.y;
 		vDroppedFilesPointCache.x = (int32_t)(((float)x / (float)(vWindowSize.x - (vViewPos.x * 2)) * (float)vScreenSize.x));
@@ -4191,13 +6069,14 @@ namespace olc
 	{ return bAtomActive; }
 
 	void PixelGameEngine::olc_Terminate()
-	{ bAtomActive = false; }
+	{ bAtomActive = false; SignalIdle(); }
 
 	void PixelGameEngine::EngineThread()
 	{
 		// Allow platform to do stuff here if needed, since its now in the
 		// context of this thread
 		if (platform->ThreadStartUp() == olc::FAIL)	return;
+		Profiler::SetThreadName("Engine");
 
 		// Do engine context specific initialisation
 		olc_PrepareEngine();
@@ -4209,8 +6088,18 @@ namespace olc
 
 		while (bAtomActive)
 		{
-			// Run as fast as possible
-			while (bAtomActive) { olc_CoreUpdate(); }
+			// Run as fast as possible, or as the frame rate limit allows
+			while (bAtomActive)
+			{
+				if (bPipelined && !bIdleMode && !bManualRenderEnable)
+					RunPipelined();
+				else
+				{
+					olc_CoreUpdate();
+					PaceFrame();
+					IdleWait();
+				}
+			}
 
 			// Allow the user to free resources if they have overrided the destroy function
 			if (!OnUserDestroy())
@@ -4223,6 +6112,73 @@ namespace olc
 		platform->ThreadCleanUp();
 	}
 
+	void PixelGameEngine::PaceFrame()
+	{
+		if (fFrameRateLimit <= 0.0f) return;
+
+		using namespace std::chrono;
+		const auto dPeriod = duration_cast<steady_clock::duration>(duration<double>(1.0 / fFrameRateLimit));
+		tpNextFrame += dPeriod;
+		auto tpNow = steady_clock::now();
+
+		// More than a frame behind, start the schedule afresh rather than
+		// presenting a burst of frames to catch up
+		if (tpNow - tpNextFrame > dPeriod)
+		{
+			tpNextFrame = tpNow;
+			return;
+		}
+
+		OLC_PROFILE_SCOPE("PaceFrame");
+		// Sleeping is cheap but imprecise, so stop short and spin the rest
+		const auto tpWake = tpNextFrame - duration_cast<steady_clock::duration>(dSleepMargin);
+		if (tpNow < tpWake)
+		{
+			std::this_thread::sleep_until(tpWake);
+			tpNow = steady_clock::now();
+			dSleepMargin = std::min(std::max(dSleepMargin * 0.95, duration<double>(tpNow - tpWake) + duration<double>(microseconds(100))), duration<double>(milliseconds(2)));
+		}
+		while (steady_clock::now() < tpNextFrame)
+			std::this_thread::yield();
+	}
+
+	void PixelGameEngine::IdleWait()
+	{
+		if (!bIdleMode || !bAtomActive) return;
+		const float fTimeout = fIdleWakeInterval > 0.0f ? fIdleWakeInterval : -1.0f;
+		{
+			std::unique_lock<std::mutex> lock(muxIdle);
+			if (bIdleWake)
+			{
+				// The frame about to run answers the platform's wake too
+				platform->ClearSystemEventWake();
+				return;
+			}
+		}
+
+		OLC_PROFILE_SCOPE("IdleWait");
+		// Platforms that handle events on this thread wait on them directly,
+		// the rest are heard from through SignalIdle()
+		if (platform->WaitSystemEvent(fTimeout) == olc::rcode::OK) return;
+
+		std::unique_lock<std::mutex> lock(muxIdle);
+		auto Woken = [&] { return bIdleWake || !bAtomActive; };
+		if (fTimeout < 0.0f)
+			cvIdle.wait(lock, Woken);
+		else
+			cvIdle.wait_for(lock, std::chrono::duration<float>(fTimeout), Woken);
+	}
+
+	void PixelGameEngine::SignalIdle()
+	{
+		if (!bIdleMode) return;
+		{
+			std::unique_lock<std::mutex> lock(muxIdle);
+			bIdleWake = true;
+		}
+		cvIdle.notify_one();
+	}
+
 	void PixelGameEngine::olc_PrepareEngine()
 	{
 		// Start OpenGL, the context is owned by the game thread
@@ -4237,8 +6193,9 @@ namespace olc
 		vLayers[0].bShow = true;
 		SetDrawTarget(nullptr);
 
-		m_tp1 = std::chrono::system_clock::now();
-		m_tp2 = std::chrono::system_clock::now();
+		m_tp1 = std::chrono::steady_clock::now();
+		m_tp2 = std::chrono::steady_clock::now();
+		tpNextFrame = m_tp1;
 	}
 
 
@@ -4267,6 +6224,7 @@ namespace olc
 
 	void PixelGameEngine::adv_FlushLayer(const size_t nLayerID)
 	{
+		adv_FlushDeferredDraw();
 		auto& layer = vLayers[nLayerID];
 
 		if (layer.bShow)
@@ -4276,7 +6234,7 @@ namespace olc
 				renderer->ApplyTexture(layer.pDrawTarget.Decal()->id);
 				if (!bSuspendTextureTransfer)
 				{
-					layer.pDrawTarget.Decal()->Update();
+					layer.pDrawTarget.Decal()->UpdateDirty();
 					layer.bUpdate = false;
 				}
 
@@ -4296,16 +6254,15 @@ namespace olc
 					vScreenSpacePos.y - (2.0f * (float(layer.pDrawTarget.Sprite()->height) * vInvScreenSize.y)) * layer.vScale.y
 				};
 
-				DecalInstance di;
+				DecalInstance di = layer.decalArena.Allocate(4);
 				di.decal = layer.pDrawTarget.Decal();
-				di.points = 4;
-				di.tint = { olc::WHITE, olc::WHITE, olc::WHITE, olc::WHITE };
-				di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
-				di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
-				di.w = { 1, 1, 1, 1 };
+				di.pos[0] = { vScreenSpacePos.x, vScreenSpacePos.y }; di.pos[1] = { vScreenSpacePos.x, vScreenSpaceDim.y };
+				di.pos[2] = { vScreenSpaceDim.x, vScreenSpaceDim.y }; di.pos[3] = { vScreenSpaceDim.x, vScreenSpacePos.y };
+				di.uv[0] = { 0.0f, 0.0f }; di.uv[1] = { 0.0f, 1.0f }; di.uv[2] = { 1.0f, 1.0f }; di.uv[3] = { 1.0f, 0.0f };
 				di.mode = DecalMode::NORMAL;
 				di.structure = DecalStructure::FAN;
 				renderer->DrawDecal(di);
+				renderer->FlushDecals();
 			}
 			else
 			{
@@ -4317,19 +6274,165 @@ namespace olc
 
 	void PixelGameEngine::adv_FlushLayerDecals(const size_t nLayerID)
 	{
-		// Display Decals in order for this layer
-		auto& layer = vLayers[nLayerID];
+		DrawLayerDecals(vLayers[nLayerID]);
+	}
+
+	void PixelGameEngine::DrawLayerDecals(olc::LayerDesc& layer)
+	{
+		OLC_PROFILE_SCOPE("DrawLayerDecals");
+		if (layer.bSortDecals)
+		{
+			// Submission order breaks ties, so equal keys keep their relative layering
+			// unless they differ in state, where grouping them is the point
+			std::sort(layer.vecDecalInstance.begin(), layer.vecDecalInstance.end(),
+				[](const olc::DecalInstance& a, const olc::DecalInstance& b)
+				{
+					if (a.key != b.key) return a.key < b.key;
+					const int32_t nTexA = a.decal == nullptr ? -1 : a.decal->id;
+					const int32_t nTexB = b.decal == nullptr ? -1 : b.decal->id;
+					if (nTexA != nTexB) return nTexA < nTexB;
+					if (a.mode != b.mode) return a.mode < b.mode;
+					if (a.structure != b.structure) return a.structure < b.structure;
+					return a.order < b.order;
+				});
+		}
+
+		// Display Decals in order for this layer, the renderer only hearing
+		// about the clip when it changes
+		olc::vf2d vClipLo = { -1.0f, -1.0f }, vClipHi = { 1.0f, 1.0f };
 		for (auto& decal : layer.vecDecalInstance)
-			renderer->DrawDecal(decal);
+		{
+			if (decal.clipMin != vClipLo || decal.clipMax != vClipHi)
+			{
+				vClipLo = decal.clipMin; vClipHi = decal.clipMax;
+				renderer->SetDecalClip(vClipLo, vClipHi);
+			}
+
+			if (layer.decalArena.Bind(decal).instanceCount > 0)
+				renderer->DrawDecalInstanced(decal);
+			else
+				renderer->DrawDecal(decal);
+		}
+		renderer->FlushDecals();
+		if (vClipLo != olc::vf2d(-1.0f, -1.0f) || vClipHi != olc::vf2d(1.0f, 1.0f))
+			renderer->SetDecalClip({ -1.0f, -1.0f }, { 1.0f, 1.0f });
+		if (bKeepLayerDecals) return;
 		layer.vecDecalInstance.clear();
+		layer.decalArena.Clear();
+	}
+
+	void PixelGameEngine::adv_DeferredDrawEnable(const bool bEnable, const uint32_t nWorkers)
+	{
+		adv_FlushDeferredDraw();
+		DeferredStopWorkers();
+		bDeferredDraw = bEnable;
+		if (!bEnable) return;
+
+		// The engine thread rasterises too, so it counts as one of the workers
+		uint32_t n = nWorkers > 0 ? nWorkers : std::max(1u, std::thread::hardware_concurrency());
+		for (uint32_t i = 1; i < n; i++)
+			vDeferredWorkers.emplace_back([this, nJob = nDeferredJob]() { DeferredWorker(nJob); });
+	}
+
+	void PixelGameEngine::adv_FlushDeferredDraw()
+	{
+		if (std::all_of(vDeferredTiles.begin(), vDeferredTiles.end(), [](const auto& tile) { return tile.empty(); }))
+			return;
+
+		OLC_PROFILE_SCOPE("FlushDeferredDraw");
+		nDeferredNextTile = 0;
+		{
+			std::unique_lock<std::mutex> lock(muxDeferred);
+			nDeferredBusy = vDeferredWorkers.size();
+			nDeferredJob++;
+		}
+		cvDeferredWork.notify_all();
+
+		DeferredRasterise();
+
+		{
+			std::unique_lock<std::mutex> lock(muxDeferred);
+			cvDeferredDone.wait(lock, [&] { return nDeferredBusy == 0; });
+		}
+
+		for (auto& tile : vDeferredTiles) tile.clear();
+		vDeferredSource.clear();
+		vDeferredCustom.clear();
+		nDeferredCustomVersion = 0xFFFFFFFF;
+	}
+
+	void PixelGameEngine::DeferredWorker(uint64_t nJob)
+	{
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(muxDeferred);
+				cvDeferredWork.wait(lock, [&] { return bDeferredQuit || nDeferredJob != nJob; });
+				if (bDeferredQuit) return;
+				nJob = nDeferredJob;
+			}
+
+			DeferredRasterise();
+
+			{
+				std::unique_lock<std::mutex> lock(muxDeferred);
+				if (--nDeferredBusy == 0) cvDeferredDone.notify_one();
+			}
+		}
 	}
 
+	// Pulls whole tiles until none are left, spans within a tile are replayed
+	// in the order they were drawn
+	void PixelGameEngine::DeferredRasterise()
+	{
+		std::vector<olc::Pixel> vFill;
+		for (size_t t = nDeferredNextTile++; t < vDeferredTiles.size(); t = nDeferredNextTile++)
+		{
+			for (const auto& span : vDeferredTiles[t])
+			{
+				Pixel* pDst = span.pTarget->pColData.data() + size_t(span.y) * size_t(span.pTarget->width) + span.x;
+				auto Rasterise = [&](const auto& mode)
+				{
+					if (span.nSource == nDeferredNoSource)
+						mode.Fill(span.x, span.y, pDst, span.w, span.p);
+					else
+						mode.Copy(span.x, span.y, pDst, vDeferredSource.data() + span.nSource, span.w);
+				};
+
+				switch (span.nMode)
+				{
+				case Pixel::NORMAL: Rasterise(pixelmode::Normal{}); break;
+				case Pixel::MASK:   Rasterise(pixelmode::Mask{}); break;
+				case Pixel::ALPHA:  Rasterise(pixelmode::Alpha{ span.nParam }); break;
+				case Pixel::CUSTOM: Rasterise(pixelmode::Custom{ vDeferredCustom[span.nParam].first, vDeferredCustom[span.nParam].second, vFill }); break;
+				}
+			}
+		}
+	}
 
+	void PixelGameEngine::DeferredStopWorkers()
+	{
+		{
+			std::unique_lock<std::mutex> lock(muxDeferred);
+			bDeferredQuit = true;
+		}
+		cvDeferredWork.notify_all();
+		for (auto& t : vDeferredWorkers) t.join();
+		vDeferredWorkers.clear();
+		bDeferredQuit = false;
+	}
 
 	void PixelGameEngine::olc_CoreUpdate()
+	{
+		OLC_PROFILE_SCOPE("Frame");
+		UpdateFrame();
+		RenderFrame();
+	}
+
+	void PixelGameEngine::UpdateFrame()
 	{
 		// Handle Timing
-		m_tp2 = std::chrono::system_clock::now();
+		m_tp2 = std::chrono::steady_clock::now();
 		std::chrono::duration<float> elapsedTime = m_tp2 - m_tp1;
 		m_tp1 = m_tp2;
 
@@ -4337,11 +6440,40 @@ namespace olc
 		float fElapsedTime = elapsedTime.count();
 		fLastElapsed = fElapsedTime;
 
+		// The overlay shows the frame that ends here
+		const int64_t nProfilePrevStart = nProfileFrameStart;
+		if (bProfilerOverlay) nProfileFrameStart = Profiler::Now();
+
+		// With a fixed timestep, update once for every step of time owed
+		uint32_t nUpdates = 1;
+		if (fFixedStep > 0.0f && !bConsoleSuspendTime)
+		{
+			fFixedTimeOwed += fElapsedTime;
+			nUpdates = uint32_t(fFixedTimeOwed / fFixedStep);
+			fFixedTimeOwed -= float(nUpdates) * fFixedStep;
+			if (nUpdates > nMaxFixedUpdates)
+			{
+				nUpdates = nMaxFixedUpdates;
+				fFixedTimeOwed = 0.0f;
+			}
+			fElapsedTime = fFixedStep;
+		}
+
 		if (bConsoleSuspendTime)
 			fElapsedTime = 0.0f;
 
 		// Some platforms will need to check for events
-		platform->HandleSystemEvent();
+		{
+			OLC_PROFILE_SCOPE("HandleSystemEvent");
+			platform->HandleSystemEvent();
+		}
+
+		// This frame takes care of everything signalled so far
+		if (bIdleMode)
+		{
+			std::unique_lock<std::mutex> lock(muxIdle);
+			bIdleWake = false;
+		}
 
 		// Compare hardware input states from previous frame
 		auto ScanHardware = [&](HWButton* pKeys, bool* pStateOld, bool* pStateNew, uint32_t nKeyCount)
@@ -4367,34 +6499,68 @@ namespace olc
 			}
 		};
 
-		ScanHardware(pKeyboardState, pKeyOldState, pKeyNewState, 256);
-		ScanHardware(pMouseState, pMouseOldState, pMouseNewState, nMouseButtons);
+		float fUserTime = 0.0f;
+		for (uint32_t nUpdate = 0; nUpdate < nUpdates; nUpdate++)
+		{
+			if (nUpdate == 0)
+			{
+				OLC_PROFILE_SCOPE("Input");
+				ScanHardware(pKeyboardState, pKeyOldState, pKeyNewState, 256);
+				ScanHardware(pMouseState, pMouseOldState, pMouseNewState, nMouseButtons);
 
-		// Cache mouse coordinates so they remain consistent during frame
-		vMousePos = vMousePosCache;
-		nMouseWheelDelta = nMouseWheelDeltaCache;
-		nMouseWheelDeltaCache = 0;
+				// Cache mouse coordinates so they remain consistent during frame
+				vMousePos = vMousePosCache;
+				nMouseWheelDelta = nMouseWheelDeltaCache;
+				nMouseWheelDeltaCache = 0;
 
-		vDroppedFiles = vDroppedFilesCache;
-		vDroppedFilesPoint = vDroppedFilesPointCache;
-		vDroppedFilesCache.clear();
+				vDroppedFiles = vDroppedFilesCache;
+				vDroppedFilesPoint = vDroppedFilesPointCache;
+				vDroppedFilesCache.clear();
 
-		if (bTextEntryEnable)
-		{
-			UpdateTextEntry();
-		}
+				if (bTextEntryEnable)
+				{
+					UpdateTextEntry();
+				}
+			}
+			else
+			{
+				// Input that arrived with the frame is seen by its first update only
+				for (auto& key : pKeyboardState) key.bPressed = key.bReleased = false;
+				for (auto& button : pMouseState) button.bPressed = button.bReleased = false;
+				nMouseWheelDelta = 0;
+				vDroppedFiles.clear();
+			}
 
-		// Handle Frame Update
-		bool bExtensionBlockFrame = false;		
-		for (auto& ext : vExtensions) bExtensionBlockFrame |= ext->OnBeforeUserUpdate(fElapsedTime);
-		if (!bExtensionBlockFrame)
-		{
-			if (!OnUserUpdate(fElapsedTime)) bAtomActive = false;
-			
-		}
-		for (auto& ext : vExtensions) ext->OnAfterUserUpdate(fElapsedTime);
+			// Only the last update's decals are shown, and they stay until the next
+			// one, as frames between steps present what is already there
+			if (fFixedStep > 0.0f)
+				for (auto& layer : vLayers)
+				{
+					layer.vecDecalInstance.clear();
+					layer.decalArena.Clear();
+				}
 
-		
+			// Handle Frame Update
+			bool bExtensionBlockFrame = false;
+			for (auto& ext : vExtensions)
+			{
+				OLC_PROFILE_SCOPE("PGEX::OnBeforeUserUpdate");
+				bExtensionBlockFrame |= ext->OnBeforeUserUpdate(fElapsedTime);
+			}
+			if (!bExtensionBlockFrame)
+			{
+				OLC_PROFILE_SCOPE("OnUserUpdate");
+				const auto tpUser = std::chrono::steady_clock::now();
+				if (!OnUserUpdate(fElapsedTime)) bAtomActive = false;
+				fUserTime += std::chrono::duration<float>(std::chrono::steady_clock::now() - tpUser).count();
+
+			}
+			for (auto& ext : vExtensions)
+			{
+				OLC_PROFILE_SCOPE("PGEX::OnAfterUserUpdate");
+				ext->OnAfterUserUpdate(fElapsedTime);
+			}
+		}
 
 		if (bRealWindowMode)
 		{
@@ -4405,72 +6571,357 @@ namespace olc
 
 		if (!bManualRenderEnable)
 		{
-			if (bConsoleShow)
+			// Like the update's, the console's decals last until the next update
+			// and it reads input only taken on frames with one
+			if (bConsoleShow && nUpdates > 0)
 			{
+				OLC_PROFILE_SCOPE("UpdateConsole");
 				SetDrawTarget((uint8_t)0);
 				UpdateConsole();
 			}
 
-			// Display Frame
-			renderer->UpdateViewport(vViewPos, vViewSize);
-			renderer->ClearBuffer(olc::BLACK, true);
+			// Layers must be complete before they are uploaded
+			adv_FlushDeferredDraw();
 
 			// Layer 0 must always exist
 			vLayers[0].bUpdate = true;
 			vLayers[0].bShow = true;
 			SetDecalMode(DecalMode::NORMAL);
+
+			if (bProfilerOverlay && nUpdates > 0 && nProfilePrevStart > 0)
+				DrawProfilerOverlay(nProfilePrevStart, nProfileFrameStart);
+		}
+
+		statsFrame.fUserUpdateTime += fUserTime;
+		statsFrame.fEngineTime += std::chrono::duration<float>(std::chrono::steady_clock::now() - m_tp2).count() - fUserTime;
+	}
+
+	void PixelGameEngine::RenderFrame()
+	{
+		const auto tpStart = std::chrono::steady_clock::now();
+		bKeepLayerDecals = fFixedStep > 0.0f;
+		if (!bManualRenderEnable)
+		{
+			UploadLayers();
+
+			// Display Frame
+			renderer->UpdateViewport(vViewPos, vViewSize);
+			renderer->ClearBuffer(olc::BLACK, true);
 			renderer->PrepareDrawing();
 
 			for (auto layer = vLayers.rbegin(); layer != vLayers.rend(); ++layer)
+				DrawLayer(*layer, layer->pDrawTarget.Decal()->id);
+		}
+
+		PresentFrame();
+		fRenderTime += std::chrono::duration<float>(std::chrono::steady_clock::now() - tpStart).count();
+		EndFrame();
+	}
+
+	void PixelGameEngine::UploadLayers()
+	{
+		if (bSuspendTextureTransfer) return;
+		for (auto& layer : vLayers)
+		{
+			if (layer.bShow && layer.funcHook == nullptr && layer.bUpdate)
 			{
-				if (layer->bShow)
-				{
-					if (layer->funcHook == nullptr)
-					{
-						renderer->ApplyTexture(layer->pDrawTarget.Decal()->id);
-						if (!bSuspendTextureTransfer && layer->bUpdate)
-						{
-							layer->pDrawTarget.Decal()->Update();
-							layer->bUpdate = false;
-						}
+				OLC_PROFILE_SCOPE("UploadLayer");
+				// Only what was drawn to since the last upload is sent
+				layer.pDrawTarget.Decal()->UpdateDirty();
+				layer.bUpdate = false;
+			}
+		}
+	}
+
+	void PixelGameEngine::DrawLayer(olc::LayerDesc& layer, const int32_t nTextureID)
+	{
+		if (!layer.bShow) return;
+		if (layer.funcHook == nullptr)
+		{
+			renderer->ApplyTexture(nTextureID);
+			renderer->DrawLayerQuad(layer.vOffset, layer.vScale, layer.tint);
+			DrawLayerDecals(layer);
+		}
+		else
+		{
+			// Mwa ha ha.... Have Fun!!!
+			layer.funcHook();
+		}
+	}
+
+	void PixelGameEngine::PresentFrame()
+	{
+		// Present Graphics to screen
+		{
+			OLC_PROFILE_SCOPE("DisplayFrame");
+			renderer->DisplayFrame();
+		}
+
+		if (pFrameWriter != nullptr)
+		{
+			OLC_PROFILE_SCOPE("FrameWriter::Submit");
+			const olc::Sprite* frame = renderer->GetFrame();
+			if (frame != nullptr) pFrameWriter->Submit(*frame);
+		}
+	}
+
+	void PixelGameEngine::EndFrame()
+	{
+		nLastDecalsCulled = nDecalsCulled;
+		nDecalsCulled = 0;
+		CollectFrameStats();
+
+		if (bResizeRequested)
+		{
+			bResizeRequested = false;
+			SetScreenSize(vWindowSize.x, vWindowSize.y);
+			renderer->UpdateViewport({ 0,0 }, vWindowSize);
+		}
+
+		// Update Title Bar
+		fFrameTimer += fLastElapsed;
+		nFrameCount++;
+		if (fFrameTimer >= 1.0f)
+		{
+			nLastFPS = nFrameCount;
+			fFrameTimer -= 1.0f;
+			std::string sTitle = "OneLoneCoder.com - Pixel Game Engine - " + sAppName + " - FPS: " + std::to_string(nFrameCount);
+			platform->SetWindowTitle(sTitle);
+			nFrameCount = 0;
+		}
+	}
+
+	void PixelGameEngine::CollectFrameStats()
+	{
+		std::swap(statsLast, statsFrame);
+		statsLast.vLayers.resize(vLayers.size());
+		statsLast.renderer = renderer->stats;
+		statsLast.fFrameTime = fLastElapsed;
+		statsLast.fEngineTime += fRenderTime;
+		renderer->stats = {};
+		fRenderTime = 0.0f;
+
+		// Counting restarts from zero, keeping the layer list's storage
+		statsFrame.nPixelsDrawn.fill(0);
+		std::fill(statsFrame.vLayers.begin(), statsFrame.vLayers.end(), olc::FrameStats::Layer());
+		statsFrame.fUserUpdateTime = 0.0f;
+		statsFrame.fEngineTime = 0.0f;
+
+		vFrameTimes[nFrameTimes++ % vFrameTimes.size()] = fLastElapsed;
+		const size_t nHistory = std::min(nFrameTimes, vFrameTimes.size());
+		std::array<float, olc::FrameStats::nFrameHistory> vSorted = vFrameTimes;
+		// Nearest rank, ceil(0.99 * n) - 1, kept in integers
+		const auto itP99 = vSorted.begin() + (nHistory * 99 + 99) / 100 - 1;
+		std::nth_element(vSorted.begin(), itP99, vSorted.begin() + nHistory);
+		statsLast.fFrameTimeP99 = *itP99;
+		statsLast.fFrameTimeMin = *std::min_element(vSorted.begin(), vSorted.begin() + nHistory);
+		statsLast.fFrameTimeMean = std::accumulate(vSorted.begin(), vSorted.begin() + nHistory, 0.0f) / float(nHistory);
+	}
+
+	void PixelGameEngine::EnablePipelinedUpdate(const bool bEnable)
+	{ bPipelined = bEnable; }
+
+	void PixelGameEngine::EnableProfilerOverlay(const bool bEnable)
+	{
+		bProfilerOverlay = bEnable;
+		nProfileFrameStart = 0;
+		if (bEnable) Profiler::Enable(true);
+	}
+
+	void PixelGameEngine::DrawProfilerOverlay(const int64_t nFrom, const int64_t nTo)
+	{
+		std::vector<olc::Profiler::Zone> vZones;
+		olc::Profiler::GetZones(nFrom, vZones);
+
+		// Total each zone by name, longest first
+		struct ZoneTotal { const char* sName; int64_t nTime; uint32_t nCount; };
+		std::vector<ZoneTotal> vTotals;
+		for (const auto& z : vZones)
+		{
+			if (z.nEnd > nTo) continue;
+			auto it = std::find_if(vTotals.begin(), vTotals.end(), [&](const ZoneTotal& t) { return std::strcmp(t.sName, z.sName) == 0; });
+			if (it == vTotals.end()) it = vTotals.insert(vTotals.end(), { z.sName, 0, 0 });
+			it->nTime += z.nEnd - z.nStart;
+			it->nCount++;
+		}
+		std::sort(vTotals.begin(), vTotals.end(), [](const ZoneTotal& a, const ZoneTotal& b) { return a.nTime > b.nTime; });
+
+		const uint8_t nLayer = nTargetLayer;
+		nTargetLayer = 0;
+
+		// Text at one window pixel per font pixel, whatever the pixel size
+		const olc::vf2d vScale = { 1.0f / float(vPixelSize.x), 1.0f / float(vPixelSize.y) };
+		const olc::vf2d vLine = { 0.0f, 10.0f * vScale.y };
+		const olc::vf2d vPos = olc::vf2d(4.0f, 4.0f) * vScale;
+		FillRectDecal(vPos - olc::vf2d(2.0f, 2.0f) * vScale, olc::vf2d(8.0f * 31.0f + 4.0f, 10.0f * float(vTotals.size() + 1) + 2.0f) * vScale, olc::Pixel(0, 0, 0, 160));
+
+		char sLine[64];
+		std::snprintf(sLine, sizeof(sLine), "%-20s%7s%4s", "Zone", "ms", "n");
+		DrawStringDecal(vPos, sLine, olc::YELLOW, vScale);
+		for (size_t i = 0; i < vTotals.size(); i++)
+		{
+			std::snprintf(sLine, sizeof(sLine), "%-20.20s%7.2f%4u", vTotals[i].sName, double(vTotals[i].nTime) * 1e-6, vTotals[i].nCount);
+			DrawStringDecal(vPos + vLine * float(i + 1), sLine, olc::WHITE, vScale);
+		}
+		nTargetLayer = nLayer;
+	}
+
+	void PixelGameEngine::adv_RunOnRenderThread(const std::function<void()>& func)
+	{
+		std::unique_lock<std::mutex> lock(muxPipeline);
+		if (!bPipelineRunning || std::this_thread::get_id() == idRenderThread)
+		{
+			lock.unlock();
+			func();
+			return;
+		}
+
+		bool bDone = false;
+		vRenderCalls.push_back({ &func, &bDone });
+		cvPipeline.notify_all();
+		cvPipeline.wait(lock, [&] { return bDone; });
+	}
+
+	void PixelGameEngine::ServiceRenderCalls(std::unique_lock<std::mutex>& lock)
+	{
+		while (!vRenderCalls.empty())
+		{
+			auto vCalls = std::move(vRenderCalls);
+			vRenderCalls.clear();
+			lock.unlock();
+			for (auto& call : vCalls) (*call.first)();
+			lock.lock();
+			for (auto& call : vCalls) *call.second = true;
+			cvPipeline.notify_all();
+		}
+	}
+
+	void PixelGameEngine::PipelinedUpdateThread()
+	{
+		Profiler::SetThreadName("Update");
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(muxPipeline);
+				cvPipeline.wait(lock, [&] { return bUpdateGo; });
+				bUpdateGo = false;
+				if (bUpdateQuit) return;
+			}
+
+			{
+				OLC_PROFILE_SCOPE("Update");
+				UpdateFrame();
+			}
+
+			{
+				std::unique_lock<std::mutex> lock(muxPipeline);
+				bUpdateReady = true;
+			}
+			cvPipeline.notify_all();
+		}
+	}
+
+	void PixelGameEngine::RunPipelined()
+	{
+		{
+			std::unique_lock<std::mutex> lock(muxPipeline);
+			idRenderThread = std::this_thread::get_id();
+			bPipelineRunning = true;
+			bUpdateGo = true;
+			bUpdateReady = false;
+			bUpdateQuit = false;
+		}
+		std::thread tUpdate(&PixelGameEngine::PipelinedUpdateThread, this);
 
-						renderer->DrawLayerQuad(layer->vOffset, layer->vScale, layer->tint);
+		bool bContinue = true;
+		std::chrono::steady_clock::time_point tpRender;
+		while (bContinue)
+		{
+			// Wait for the update to finish, doing any renderer work it asks for
+			{
+				OLC_PROFILE_SCOPE("PipelineWait");
+				std::unique_lock<std::mutex> lock(muxPipeline);
+				while (!bUpdateReady)
+				{
+					cvPipeline.wait(lock, [&] { return bUpdateReady || !vRenderCalls.empty(); });
+					ServiceRenderCalls(lock);
+				}
+				bUpdateReady = false;
+			}
 
-						// Display Decals in order for this layer
-						for (auto& decal : layer->vecDecalInstance)
-							renderer->DrawDecal(decal);
-						layer->vecDecalInstance.clear();
+			// Both threads are at the frame boundary, hand the frame over
+			{
+				OLC_PROFILE_SCOPE("PipelineHandoff");
+				bContinue = bAtomActive && bPipelined && !bIdleMode && !bManualRenderEnable;
+				EndFrame();
+				tpRender = std::chrono::steady_clock::now();
+				UploadLayers();
+				vPipelinedLayers.resize(vLayers.size());
+				for (size_t i = 0; i < vLayers.size(); i++)
+				{
+					olc::LayerDesc& layer = vLayers[i];
+					PipelinedLayer& pl = vPipelinedLayers[i];
+					pl.nTextureID = layer.pDrawTarget.Decal() != nullptr ? layer.pDrawTarget.Decal()->id : -1;
+					pl.desc.vOffset = layer.vOffset;
+					pl.desc.vScale = layer.vScale;
+					pl.desc.bShow = layer.bShow;
+					pl.desc.tint = layer.tint;
+					pl.desc.funcHook = layer.funcHook;
+					pl.desc.bSortDecals = layer.bSortDecals;
+
+					// A fixed timestep keeps decals across frames, so they are copied
+					if (fFixedStep > 0.0f)
+					{
+						pl.desc.vecDecalInstance = layer.vecDecalInstance;
+						pl.desc.decalArena = layer.decalArena;
 					}
 					else
 					{
-						// Mwa ha ha.... Have Fun!!!
-						layer->funcHook();
+						std::swap(pl.desc.vecDecalInstance, layer.vecDecalInstance);
+						std::swap(pl.desc.decalArena, layer.decalArena);
+						layer.vecDecalInstance.clear();
+						layer.decalArena.Clear();
 					}
 				}
-			}
-		}	
+				vPipelinedViewPos = vViewPos;
+				vPipelinedViewSize = vViewSize;
+				bKeepLayerDecals = fFixedStep > 0.0f;
 
-		// Present Graphics to screen
-		renderer->DisplayFrame();
+				if (bContinue)
+				{
+					{
+						std::unique_lock<std::mutex> lock(muxPipeline);
+						bUpdateGo = true;
+					}
+					cvPipeline.notify_all();
+				}
+			}
 
-		if (bResizeRequested)
-		{
-			bResizeRequested = false;
-			SetScreenSize(vWindowSize.x, vWindowSize.y);
-			renderer->UpdateViewport({ 0,0 }, vWindowSize);
+			// Meanwhile, draw and present the frame just updated
+			{
+				OLC_PROFILE_SCOPE("Render");
+				renderer->UpdateViewport(vPipelinedViewPos, vPipelinedViewSize);
+				renderer->ClearBuffer(olc::BLACK, true);
+				renderer->PrepareDrawing();
+				for (auto layer = vPipelinedLayers.rbegin(); layer != vPipelinedLayers.rend(); ++layer)
+					DrawLayer(layer->desc, layer->nTextureID);
+				PresentFrame();
+			}
+			fRenderTime += std::chrono::duration<float>(std::chrono::steady_clock::now() - tpRender).count();
+			if (bContinue) PaceFrame();
 		}
 
-		// Update Title Bar
-		fFrameTimer += fElapsedTime;
-		nFrameCount++;
-		if (fFrameTimer >= 1.0f)
 		{
-			nLastFPS = nFrameCount;
-			fFrameTimer -= 1.0f;
-			std::string sTitle = "OneLoneCoder.com - Pixel Game Engine - " + sAppName + " - FPS: " + std::to_string(nFrameCount);
-			platform->SetWindowTitle(sTitle);
-			nFrameCount = 0;
+			std::unique_lock<std::mutex> lock(muxPipeline);
+			bUpdateQuit = true;
+			bUpdateGo = true;
 		}
+		cvPipeline.notify_all();
+		tUpdate.join();
+
+		std::unique_lock<std::mutex> lock(muxPipeline);
+		bPipelineRunning = false;
+		vPipelinedLayers.clear();
 	}
 
 	void PixelGameEngine::olc_ConstructFontSheet()
@@ -4524,6 +6975,25 @@ namespace olc
 
 		for (auto c : vSpacing) vFontSpacing.push_back({ c >> 4, c & 15 });
 
+		// Bit pack the glyphs, so text rendering never needs to touch the font sprite
+		for (size_t g = 0; g < 96; g++)
+		{
+			const int32_t ox = int32_t(g % 16) * 8, oy = int32_t(g / 16) * 8;
+			const uint64_t nPropRow = (1ull << vFontSpacing[g].y) - 1;
+			uint64_t nMask = 0, nMaskProp = 0;
+			for (int32_t j = 0; j < 8; j++)
+			{
+				uint64_t nRow = 0;
+				for (int32_t i = 0; i < 8; i++)
+					if (fontRenderable.Sprite()->GetPixel(ox + i, oy + j).r > 0)
+						nRow |= 1ull << i;
+				nMask |= nRow << (j * 8);
+				nMaskProp |= ((nRow >> vFontSpacing[g].x) & nPropRow) << (j * 8);
+			}
+			vFontMask[g] = nMask;
+			vFontMaskProp[g] = nMaskProp;
+		}
+
 		// UK Standard Layout
 #ifdef OLC_KEYBOARD_UK
 		vKeyboardMap =
@@ -4591,8 +7061,10 @@ namespace olc
 		virtual void	   SetDecalMode(const olc::DecalMode& mode) {}
 		virtual void       DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) {}
 		virtual void       DrawDecal(const olc::DecalInstance& decal) {}
+		virtual void       FlushDecals() {}
 		virtual uint32_t   CreateTexture(const uint32_t width, const uint32_t height, const bool filtered = false, const bool clamp = true) {return 1;};
 		virtual void       UpdateTexture(uint32_t id, olc::Sprite* spr) {}
+		virtual void       UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) {}
 		virtual void       ReadTexture(uint32_t id, olc::Sprite* spr) {}
 		virtual uint32_t   DeleteTexture(const uint32_t id) {return 1;}
 		virtual void       ApplyTexture(uint32_t id) {}
@@ -4607,87 +7079,643 @@ namespace olc
 		virtual olc::rcode SetWindowSize(const olc::vi2d& vPos, const olc::vi2d& vSize) override
 		{ return olc::rcode::OK; }
 
-		virtual olc::rcode ShowWindowFrame(const bool bShowFrame = true) override
-		{ return olc::rcode::OK; }
+		virtual olc::rcode ShowWindowFrame(const bool bShowFrame = true) override
+		{ return olc::rcode::OK; }
+
+		virtual olc::rcode ApplicationStartUp() { return olc::rcode::OK; }
+		virtual olc::rcode ApplicationCleanUp() { return olc::rcode::OK; }
+		virtual olc::rcode ThreadStartUp() { return olc::rcode::OK; }
+		virtual olc::rcode ThreadCleanUp() { renderer->DestroyDevice(); return olc::rcode::OK; }
+		virtual olc::rcode CreateGraphics(bool bFullScreen, bool bEnableVSYNC, const olc::vi2d& vViewPos, const olc::vi2d& vViewSize)
+		{
+			if (renderer->CreateDevice({}, bFullScreen, bEnableVSYNC) == olc::rcode::OK)
+			{
+				renderer->UpdateViewport(vViewPos, vViewSize);
+				return olc::rcode::OK;
+			}
+			else
+				return olc::rcode::FAIL;
+		}
+		virtual olc::rcode CreateWindowPane(const olc::vi2d& vWindowPos, olc::vi2d& vWindowSize, bool bFullScreen) { return olc::rcode::OK; }
+		virtual olc::rcode SetWindowTitle(const std::string& s) { return olc::rcode::OK; }
+		virtual olc::rcode StartSystemEventLoop() { return olc::rcode::OK; }
+		virtual olc::rcode HandleSystemEvent() { return olc::rcode::OK; }
+	};
+#endif
+}
+#pragma endregion
+
+// O------------------------------------------------------------------------------O
+// | olcPixelGameEngine Renderers - the draw-y bits                               |
+// O------------------------------------------------------------------------------O
+
+#pragma region image_stb
+// O------------------------------------------------------------------------------O
+// | START IMAGE LOADER: stb_image.h, all systems, very fast                      |
+// O------------------------------------------------------------------------------O
+// Thanks to Sean Barrett - https://github.com/nothings/stb/blob/master/stb_image.h
+// MIT License - Copyright(c) 2017 Sean Barrett
+
+// Note you need to download the above file into your project folder, and
+// #define OLC_IMAGE_STB 
+// #define OLC_PGE_APPLICATION
+// #include "olcPixelGameEngine.h"
+
+#if defined(OLC_IMAGE_STB)
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+namespace olc
+{
+	class ImageLoader_STB : public olc::ImageLoader
+	{
+	public:
+		ImageLoader_STB() : ImageLoader()
+		{}
+
+		olc::rcode LoadImageResource(olc::Sprite* spr, const std::string& sImageFile, olc::ResourcePack* pack) override
+		{
+			UNUSED(pack);
+			// clear out existing sprite
+			spr->pColData.clear();
+			// Open file
+			stbi_uc* bytes = nullptr;
+			int w = 0, h = 0, cmp = 0;
+			if (pack != nullptr)
+			{
+				ResourceBuffer rb = pack->GetFileBuffer(sImageFile);
+				bytes = stbi_load_from_memory((unsigned char*)rb.vMemory.data(), rb.vMemory.size(), &w, &h, &cmp, 4);
+			}
+			else
+			{
+				// Check file exists
+				if (!_gfs::exists(sImageFile)) return olc::rcode::NO_FILE;
+				bytes = stbi_load(sImageFile.c_str(), &w, &h, &cmp, 4);
+			}
+
+			if (!bytes) return olc::rcode::FAIL;
+			spr->width = w; spr->height = h;
+			spr->pColData.resize(spr->width * spr->height);
+			std::memcpy(spr->pColData.data(), bytes, spr->width * spr->height * 4);
+			delete[] bytes;
+			return olc::rcode::OK;
+		}
+
+		olc::rcode SaveImageResource(olc::Sprite* spr, const std::string& sImageFile) override
+		{
+			return olc::rcode::OK;
+		}
+	};
+}
+#endif
+// O------------------------------------------------------------------------------O
+// | START IMAGE LOADER: stb_image.h                                              |
+// O------------------------------------------------------------------------------O
+#pragma endregion
+
+#pragma region renderer_software
+// O------------------------------------------------------------------------------O
+// | START RENDERER: Software (no GPU? no problem...)                             |
+// O------------------------------------------------------------------------------O
+#if defined(OLC_GFX_SOFTWARE)
+namespace olc
+{
+	// Composites layers and rasterises decals into a CPU side frame, following the
+	// OpenGL renderers: same blend equations, viewport, top-left fill rule and
+	// projective texture coordinates. Queued primitives are drawn by FlushDecals(),
+	// which splits the frame into bands of rows shared out between worker threads
+	class Renderer_Software : public olc::Renderer
+	{
+	public:
+		// nWorkers counts the calling thread, 0 uses one per hardware thread
+		Renderer_Software(const uint32_t nWorkers = 0)
+		{
+			nWorkerCount = nWorkers > 0 ? nWorkers : std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		~Renderer_Software() override
+		{ StopWorkers(); }
+
+		const olc::Sprite* GetFrame() const override
+		{ return &sprFrame; }
+
+	private:
+		struct Texture
+		{
+			bool bUsed = false;
+			bool bFiltered = false;
+			bool bClamp = true;
+			int32_t nWidth = 0;
+			int32_t nHeight = 0;
+			std::vector<olc::Pixel> vData;
+		};
+
+		// Position in frame pixels, y down, with pixel centres on whole numbers,
+		// then the attributes interpolated across primitives
+		enum { Z, U, V, W, R, G, B, A, ATTRIBS };
+		struct Vertex
+		{
+			float x, y;
+			float attrib[ATTRIBS];
+		};
+
+		struct Primitive
+		{
+			uint32_t v[3];
+			uint32_t nPoints;	// 2 for a line, 3 for a triangle
+			uint32_t nTexture;	// 0 samples white
+			olc::DecalMode mode;
+			bool bDepth;
+			int32_t nMinY = 0, nMaxY = 0;
+			olc::vi2d vClipMin = { 0, 0 }, vClipMax = { 0, 0 };	// Inclusive, frame pixels
+		};
+
+		static constexpr int32_t nBandHeight = 32;
+
+		olc::Sprite sprFrame;
+		std::vector<float> vDepth;
+		std::vector<Texture> vTextures;
+		olc::vi2d vViewPos = { 0, 0 };
+		olc::vi2d vViewSize = { 0, 0 };
+		olc::DecalMode nDecalMode = olc::DecalMode::NORMAL;
+		uint32_t nAppliedTexture = 0;
+		olc::vi2d vClipMin = { INT32_MIN, INT32_MIN };
+		olc::vi2d vClipMax = { INT32_MAX, INT32_MAX };
+
+		std::vector<Vertex> vVertices;
+		std::vector<Primitive> vPrimitives;
+
+		uint32_t nWorkerCount = 1;
+		std::vector<std::thread> vWorkers;
+		std::mutex muxWork;
+		std::condition_variable cvWork;
+		std::condition_variable cvDone;
+		uint64_t nJob = 0;
+		size_t nBusy = 0;
+		bool bQuit = false;
+		std::atomic<int32_t> nNextBand{ 0 };
+
+	public:
+		void PrepareDevice() override
+		{}
+
+		olc::rcode CreateDevice(std::vector<void*> params, bool bFullScreen, bool bVSYNC) override
+		{
+			UNUSED(params); UNUSED(bFullScreen); UNUSED(bVSYNC);
+			StopWorkers();
+			for (uint32_t i = 1; i < nWorkerCount; i++)
+				vWorkers.emplace_back([this, nFirstJob = nJob]() { Worker(nFirstJob); });
+			return olc::rcode::OK;
+		}
+
+		olc::rcode DestroyDevice() override
+		{
+			StopWorkers();
+			return olc::rcode::OK;
+		}
+
+		void DisplayFrame() override
+		{ FlushDecals(); }
+
+		void PrepareDrawing() override
+		{ nDecalMode = olc::DecalMode::NORMAL; }
+
+		void SetDecalMode(const olc::DecalMode& mode) override
+		{ nDecalMode = mode; }
+
+		// Rounded to window pixels as the OpenGL renderers hand them to glScissor(),
+		// then flipped into frame rows
+		void SetDecalClip(const olc::vf2d& vMin, const olc::vf2d& vMax) override
+		{
+			if (vMin.x <= -1.0f && vMin.y <= -1.0f && vMax.x >= 1.0f && vMax.y >= 1.0f)
+			{
+				vClipMin = { INT32_MIN, INT32_MIN };
+				vClipMax = { INT32_MAX, INT32_MAX };
+				return;
+			}
+
+			const olc::vi2d vLo = vViewPos + olc::vi2d(((vMin + olc::vf2d(1.0f, 1.0f)) * 0.5f * olc::vf2d(vViewSize) + olc::vf2d(0.5f, 0.5f)).floor());
+			const olc::vi2d vHi = vViewPos + olc::vi2d(((vMax + olc::vf2d(1.0f, 1.0f)) * 0.5f * olc::vf2d(vViewSize) + olc::vf2d(0.5f, 0.5f)).floor());
+			vClipMin = { vLo.x, sprFrame.height - vHi.y };
+			vClipMax = { vHi.x - 1, sprFrame.height - vLo.y - 1 };
+		}
+
+		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
+		{
+			const uint32_t n = uint32_t(vVertices.size());
+			vVertices.push_back(MakeVertex({ -1.0f, -1.0f }, { 0.0f * scale.x + offset.x, 1.0f * scale.y + offset.y }, 1.0f, 0.0f, tint));
+			vVertices.push_back(MakeVertex({ -1.0f, +1.0f }, { 0.0f * scale.x + offset.x, 0.0f * scale.y + offset.y }, 1.0f, 0.0f, tint));
+			vVertices.push_back(MakeVertex({ +1.0f, +1.0f }, { 1.0f * scale.x + offset.x, 0.0f * scale.y + offset.y }, 1.0f, 0.0f, tint));
+			vVertices.push_back(MakeVertex({ +1.0f, -1.0f }, { 1.0f * scale.x + offset.x, 1.0f * scale.y + offset.y }, 1.0f, 0.0f, tint));
+			AddPrimitive({ { n, n + 1, n + 2 }, 3, nAppliedTexture, nDecalMode, false });
+			AddPrimitive({ { n, n + 2, n + 3 }, 3, nAppliedTexture, nDecalMode, false });
+		}
+
+		void DrawDecal(const olc::DecalInstance& decal) override
+		{
+			SetDecalMode(decal.mode);
+			const uint32_t nTexture = decal.decal == nullptr ? 0 : uint32_t(decal.decal->id);
+			const uint32_t n = uint32_t(vVertices.size());
+			for (uint32_t i = 0; i < decal.points; i++)
+				vVertices.push_back(MakeVertex(decal.pos[i], decal.uv[i], decal.w[i], decal.depth ? decal.z[i] : 0.0f, decal.tint[i]));
+
+			if (decal.mode == olc::DecalMode::WIREFRAME || decal.structure == olc::DecalStructure::LINE)
+			{
+				// Wireframes close the outline, even a single line, as GL_LINE_LOOP does.
+				// A line decal is left open
+				const bool bLoop = decal.mode == olc::DecalMode::WIREFRAME;
+				const uint32_t nLines = bLoop ? decal.points : decal.points - 1;
+				for (uint32_t i = 0; i < nLines && decal.points > 1; i++)
+					AddPrimitive({ { n + i, n + (i + 1) % decal.points, 0 }, 2, nTexture, decal.mode, decal.depth });
+				return;
+			}
+
+			if (decal.structure == olc::DecalStructure::FAN)
+				for (uint32_t i = 1; i + 1 < decal.points; i++)
+					AddPrimitive({ { n, n + i, n + i + 1 }, 3, nTexture, decal.mode, decal.depth });
+			else if (decal.structure == olc::DecalStructure::STRIP)
+				for (uint32_t i = 0; i + 2 < decal.points; i++)
+					AddPrimitive({ { n + i, n + i + 1, n + i + 2 }, 3, nTexture, decal.mode, decal.depth });
+			else if (decal.structure == olc::DecalStructure::LIST)
+				for (uint32_t i = 0; i + 2 < decal.points; i += 3)
+					AddPrimitive({ { n + i, n + i + 1, n + i + 2 }, 3, nTexture, decal.mode, decal.depth });
+		}
+
+		void FlushDecals() override
+		{
+			if (vPrimitives.empty()) return;
+
+			// Each flush rasterises everything queued in one pass over the bands
+			stats.nDrawCalls++;
+			nNextBand = 0;
+			{
+				std::unique_lock<std::mutex> lock(muxWork);
+				nBusy = vWorkers.size();
+				nJob++;
+			}
+			cvWork.notify_all();
+
+			RasteriseBands();
+
+			{
+				std::unique_lock<std::mutex> lock(muxWork);
+				cvDone.wait(lock, [&] { return nBusy == 0; });
+			}
+
+			vVertices.clear();
+			vPrimitives.clear();
+		}
+
+		uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered, const bool clamp) override
+		{
+			FlushDecals();
+			auto it = std::find_if(vTextures.begin(), vTextures.end(), [](const Texture& t) { return !t.bUsed; });
+			if (it == vTextures.end()) it = vTextures.insert(vTextures.end(), Texture());
+			it->bUsed = true;
+			it->bFiltered = filtered;
+			it->bClamp = clamp;
+			it->nWidth = int32_t(width);
+			it->nHeight = int32_t(height);
+			it->vData.assign(size_t(width) * size_t(height), olc::BLANK);
+			return uint32_t(it - vTextures.begin()) + 1;
+		}
+
+		uint32_t DeleteTexture(const uint32_t id) override
+		{
+			FlushDecals();
+			if (Texture* t = GetTexture(id))
+			{
+				t->bUsed = false;
+				t->vData = {};
+			}
+			return id;
+		}
+
+		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			FlushDecals();
+			if (Texture* t = GetTexture(id))
+			{
+				stats.nBytesUploaded += uint64_t(spr->width) * uint64_t(spr->height) * sizeof(olc::Pixel);
+				t->nWidth = spr->width;
+				t->nHeight = spr->height;
+				t->vData.assign(spr->pColData.data(), spr->pColData.data() + size_t(spr->width) * size_t(spr->height));
+			}
+		}
+
+		void UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			Texture* t = GetTexture(id);
+			if (t == nullptr) return;
+			if (t->nWidth != spr->width || t->nHeight != spr->height)
+				return UpdateTexture(id, spr);
+
+			FlushDecals();
+			stats.nBytesUploaded += uint64_t(size.x) * uint64_t(size.y) * sizeof(olc::Pixel);
+			for (int32_t y = pos.y; y < pos.y + size.y; y++)
+				std::copy_n(spr->pColData.data() + size_t(y) * spr->width + pos.x, size.x, t->vData.data() + size_t(y) * t->nWidth + pos.x);
+		}
+
+		void ReadTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			FlushDecals();
+			const Texture* t = GetTexture(id);
+			if (t == nullptr || t->nWidth != spr->width || t->nHeight != spr->height) return;
+			std::copy(t->vData.begin(), t->vData.end(), spr->pColData.data());
+		}
+
+		void ApplyTexture(uint32_t id) override
+		{
+			stats.nTextureBinds++;
+			nAppliedTexture = id;
+		}
+
+		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			FlushDecals();
+			vViewPos = pos;
+			vViewSize = size;
+
+			// The frame is the whole window, the view is placed within it
+			olc::vi2d vFrame = ptrPGE->GetWindowSize();
+			if (vFrame.x <= 0 || vFrame.y <= 0) vFrame = pos + size;
+			if (vFrame.x != sprFrame.width || vFrame.y != sprFrame.height)
+			{
+				sprFrame = olc::Sprite(vFrame.x, vFrame.y);
+				vDepth.assign(size_t(vFrame.x) * size_t(vFrame.y), 1.0f);
+			}
+		}
+
+		void ClearBuffer(olc::Pixel p, bool bDepth) override
+		{
+			FlushDecals();
+			std::fill(sprFrame.pColData.begin(), sprFrame.pColData.end(), p);
+			if (bDepth) std::fill(vDepth.begin(), vDepth.end(), 1.0f);
+		}
+
+	private:
+		Texture* GetTexture(const uint32_t id)
+		{ return id > 0 && id <= vTextures.size() && vTextures[id - 1].bUsed ? &vTextures[id - 1] : nullptr; }
+
+		// Normalised device coordinates to frame pixels, with the viewport origin
+		// at the bottom left as it is in OpenGL
+		Vertex MakeVertex(const olc::vf2d& pos, const olc::vf2d& uv, const float w, const float z, const olc::Pixel col) const
+		{
+			return { float(vViewPos.x) + (pos.x + 1.0f) * 0.5f * float(vViewSize.x) - 0.5f,
+				float(sprFrame.height - vViewPos.y) - (pos.y + 1.0f) * 0.5f * float(vViewSize.y) - 0.5f,
+				{ z * 0.5f + 0.5f, uv.x, uv.y, w, float(col.r), float(col.g), float(col.b), float(col.a) } };
+		}
+
+		void AddPrimitive(Primitive p)
+		{
+			float fMinY = vVertices[p.v[0]].y, fMaxY = fMinY;
+			for (uint32_t i = 1; i < p.nPoints; i++)
+			{
+				fMinY = std::min(fMinY, vVertices[p.v[i]].y);
+				fMaxY = std::max(fMaxY, vVertices[p.v[i]].y);
+			}
+
+			// Rows a primitive can touch, or an empty range if it misses the view
+			const float fTop = float(sprFrame.height - vViewPos.y - vViewSize.y);
+			const float fBottom = float(sprFrame.height - vViewPos.y - 1);
+			if (!(fMaxY >= fTop - 1.0f && fMinY <= fBottom + 1.0f)) return;
+			p.nMinY = int32_t(std::floor(std::max(fMinY, fTop - 1.0f)));
+			p.nMaxY = int32_t(std::ceil(std::min(fMaxY, fBottom + 1.0f)));
+			p.vClipMin = vClipMin;
+			p.vClipMax = vClipMax;
+			vPrimitives.push_back(p);
+		}
+
+		void Worker(uint64_t nLastJob)
+		{
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(muxWork);
+					cvWork.wait(lock, [&] { return bQuit || nJob != nLastJob; });
+					if (bQuit) return;
+					nLastJob = nJob;
+				}
+
+				RasteriseBands();
+
+				{
+					std::unique_lock<std::mutex> lock(muxWork);
+					if (--nBusy == 0) cvDone.notify_one();
+				}
+			}
+		}
+
+		void StopWorkers()
+		{
+			{
+				std::unique_lock<std::mutex> lock(muxWork);
+				bQuit = true;
+			}
+			cvWork.notify_all();
+			for (auto& t : vWorkers) t.join();
+			vWorkers.clear();
+			bQuit = false;
+		}
 
-		virtual olc::rcode ApplicationStartUp() { return olc::rcode::OK; }
-		virtual olc::rcode ApplicationCleanUp() { return olc::rcode::OK; }
-		virtual olc::rcode ThreadStartUp() { return olc::rcode::OK; }
-		virtual olc::rcode ThreadCleanUp() { return olc::rcode::OK; }
-		virtual olc::rcode CreateGraphics(bool bFullScreen, bool bEnableVSYNC, const olc::vi2d& vViewPos, const olc::vi2d& vViewSize) { return olc::rcode::OK; }
-		virtual olc::rcode CreateWindowPane(const olc::vi2d& vWindowPos, olc::vi2d& vWindowSize, bool bFullScreen) { return olc::rcode::OK; }
-		virtual olc::rcode SetWindowTitle(const std::string& s) { return olc::rcode::OK; }
-		virtual olc::rcode StartSystemEventLoop() { return olc::rcode::OK; }
-		virtual olc::rcode HandleSystemEvent() { return olc::rcode::OK; }
-	};
-#endif
-}
-#pragma endregion
+		// Each band replays every primitive that reaches it, in order, so the
+		// bands need no synchronisation and blending order is preserved
+		void RasteriseBands()
+		{
+			const int32_t nBands = (sprFrame.height + nBandHeight - 1) / nBandHeight;
+			for (int32_t band = nNextBand++; band < nBands; band = nNextBand++)
+			{
+				// The band, clipped to the view
+				olc::vi2d vMin = { std::max(vViewPos.x, 0), std::max({ band * nBandHeight, sprFrame.height - vViewPos.y - vViewSize.y, 0 }) };
+				olc::vi2d vMax = { std::min(vViewPos.x + vViewSize.x, sprFrame.width) - 1, std::min({ (band + 1) * nBandHeight, sprFrame.height - vViewPos.y, sprFrame.height }) - 1 };
+				if (vMin.x > vMax.x || vMin.y > vMax.y) continue;
 
-// O------------------------------------------------------------------------------O
-// | olcPixelGameEngine Renderers - the draw-y bits                               |
-// O------------------------------------------------------------------------------O
+				for (const auto& p : vPrimitives)
+				{
+					if (p.nMaxY < vMin.y || p.nMinY > vMax.y) continue;
+					const olc::vi2d vLo = vMin.max(p.vClipMin), vHi = vMax.min(p.vClipMax);
+					if (vLo.x > vHi.x || vLo.y > vHi.y) continue;
+					if (p.nPoints == 3)
+						RasteriseTriangle(p, vLo, vHi);
+					else
+						RasteriseLine(p, vLo, vHi);
+				}
+			}
+		}
 
-#pragma region image_stb
-// O------------------------------------------------------------------------------O
-// | START IMAGE LOADER: stb_image.h, all systems, very fast                      |
-// O------------------------------------------------------------------------------O
-// Thanks to Sean Barrett - https://github.com/nothings/stb/blob/master/stb_image.h
-// MIT License - Copyright(c) 2017 Sean Barrett
+		static int32_t FloorDiv(const int64_t a, const int64_t b)
+		{ return int32_t(a >= 0 ? a / b : -((-a + b - 1) / b)); }
 
-// Note you need to download the above file into your project folder, and
-// #define OLC_IMAGE_STB 
-// #define OLC_PGE_APPLICATION
-// #include "olcPixelGameEngine.h"
+		static int32_t TexelIndex(const float f, const int32_t n, const bool bClamp)
+		{
+			if (bClamp) return !(f > 0.0f) ? 0 : (f >= float(n) ? n - 1 : int32_t(f));
+			const float r = f - std::floor(f / float(n)) * float(n);
+			return !(r > 0.0f) ? 0 : std::min(int32_t(r), n - 1);
+		}
 
-#if defined(OLC_IMAGE_STB)
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-namespace olc
-{
-	class ImageLoader_STB : public olc::ImageLoader
-	{
-	public:
-		ImageLoader_STB() : ImageLoader()
-		{}
+		static olc::Pixel Sample(const Texture* t, const float u, const float v)
+		{
+			if (t == nullptr || t->vData.empty()) return olc::WHITE;
+			if (!t->bFiltered)
+				return t->vData[size_t(TexelIndex(v * t->nHeight, t->nHeight, t->bClamp)) * t->nWidth + TexelIndex(u * t->nWidth, t->nWidth, t->bClamp)];
 
-		olc::rcode LoadImageResource(olc::Sprite* spr, const std::string& sImageFile, olc::ResourcePack* pack) override
+			const float fx = u * t->nWidth - 0.5f, fy = v * t->nHeight - 0.5f;
+			const float x0 = std::floor(fx), y0 = std::floor(fy);
+			const float tx = fx - x0, ty = fy - y0;
+
+			// Like GL_CLAMP, filtering past the edge mixes in a transparent border
+			auto Texel = [&](const float x, const float y)
+			{
+				if (t->bClamp && (x < 0.0f || y < 0.0f || x >= float(t->nWidth) || y >= float(t->nHeight))) return olc::BLANK;
+				return t->vData[size_t(TexelIndex(y, t->nHeight, t->bClamp)) * t->nWidth + TexelIndex(x, t->nWidth, t->bClamp)];
+			};
+			const olc::Pixel p00 = Texel(x0, y0), p10 = Texel(x0 + 1.0f, y0);
+			const olc::Pixel p01 = Texel(x0, y0 + 1.0f), p11 = Texel(x0 + 1.0f, y0 + 1.0f);
+			auto Lerp = [&](const uint8_t c00, const uint8_t c10, const uint8_t c01, const uint8_t c11)
+			{
+				const float top = c00 + (c10 - c00) * tx, bottom = c01 + (c11 - c01) * tx;
+				return uint8_t(top + (bottom - top) * ty + 0.5f);
+			};
+			return olc::Pixel(Lerp(p00.r, p10.r, p01.r, p11.r), Lerp(p00.g, p10.g, p01.g, p11.g), Lerp(p00.b, p10.b, p01.b, p11.b), Lerp(p00.a, p10.a, p01.a, p11.a));
+		}
+
+		// The glBlendFunc() equations the OpenGL renderers set for each mode
+		static olc::Pixel BlendDecal(const olc::DecalMode mode, const olc::Pixel s, const olc::Pixel d)
 		{
-			UNUSED(pack);
-			// clear out existing sprite
-			spr->pColData.clear();
-			// Open file
-			stbi_uc* bytes = nullptr;
-			int w = 0, h = 0, cmp = 0;
-			if (pack != nullptr)
+			auto Mix = [](const uint32_t sc, const uint32_t sf, const uint32_t dc, const uint32_t df)
+			{ return uint8_t(std::min(blend::Div255(sc * sf + dc * df + 128), 255u)); };
+
+			switch (mode)
 			{
-				ResourceBuffer rb = pack->GetFileBuffer(sImageFile);
-				bytes = stbi_load_from_memory((unsigned char*)rb.vMemory.data(), rb.vMemory.size(), &w, &h, &cmp, 4);
+			case olc::DecalMode::ADDITIVE:
+				return olc::Pixel(Mix(s.r, s.a, d.r, 255), Mix(s.g, s.a, d.g, 255), Mix(s.b, s.a, d.b, 255), Mix(s.a, s.a, d.a, 255));
+			case olc::DecalMode::MULTIPLICATIVE:
+				return olc::Pixel(Mix(s.r, d.r, d.r, 255 - s.a), Mix(s.g, d.g, d.g, 255 - s.a), Mix(s.b, d.b, d.b, 255 - s.a), Mix(s.a, d.a, d.a, 255 - s.a));
+			case olc::DecalMode::STENCIL:
+				return olc::Pixel(Mix(0, 0, d.r, s.a), Mix(0, 0, d.g, s.a), Mix(0, 0, d.b, s.a), Mix(0, 0, d.a, s.a));
+			case olc::DecalMode::ILLUMINATE:
+				return olc::Pixel(Mix(s.r, 255 - s.a, d.r, s.a), Mix(s.g, 255 - s.a, d.g, s.a), Mix(s.b, 255 - s.a, d.b, s.a), Mix(s.a, 255 - s.a, d.a, s.a));
+			default:
+				return olc::Pixel(Mix(s.r, s.a, d.r, 255 - s.a), Mix(s.g, s.a, d.g, 255 - s.a), Mix(s.b, s.a, d.b, 255 - s.a), Mix(s.a, s.a, d.a, 255 - s.a));
 			}
-			else
+		}
+
+		// Texture coordinates are divided by the interpolated w, as glTexCoord4f() would
+		void Shade(const Primitive& p, const Texture* t, const int32_t x, const int32_t y, const float* f)
+		{
+			const size_t i = size_t(y) * size_t(sprFrame.width) + size_t(x);
+			if (p.bDepth)
 			{
-				// Check file exists
-				if (!_gfs::exists(sImageFile)) return olc::rcode::NO_FILE;
-				bytes = stbi_load(sImageFile.c_str(), &w, &h, &cmp, 4);
+				if (f[Z] < 0.0f || f[Z] > 1.0f || !(f[Z] < vDepth[i])) return;
+				vDepth[i] = f[Z];
 			}
 
-			if (!bytes) return olc::rcode::FAIL;
-			spr->width = w; spr->height = h;
-			spr->pColData.resize(spr->width * spr->height);
-			std::memcpy(spr->pColData.data(), bytes, spr->width * spr->height * 4);
-			delete[] bytes;
-			return olc::rcode::OK;
+			const float fInvW = f[W] != 0.0f ? 1.0f / f[W] : 0.0f;
+			const olc::Pixel texel = Sample(t, f[U] * fInvW, f[V] * fInvW);
+			auto Modulate = [](const uint8_t c, const float k)
+			{ return uint8_t(float(c) * std::clamp(k, 0.0f, 255.0f) * (1.0f / 255.0f) + 0.5f); };
+			const olc::Pixel src(Modulate(texel.r, f[R]), Modulate(texel.g, f[G]), Modulate(texel.b, f[B]), Modulate(texel.a, f[A]));
+			sprFrame.pColData[i] = BlendDecal(p.mode, src, sprFrame.pColData[i]);
 		}
 
-		olc::rcode SaveImageResource(olc::Sprite* spr, const std::string& sImageFile) override
+		void RasteriseTriangle(const Primitive& p, const olc::vi2d& vMin, const olc::vi2d& vMax)
 		{
-			return olc::rcode::OK;
+			const Vertex* v[3] = { &vVertices[p.v[0]], &vVertices[p.v[1]], &vVertices[p.v[2]] };
+			const double vx[3] = { v[0]->x, v[1]->x, v[2]->x }, vy[3] = { v[0]->y, v[1]->y, v[2]->y };
+			raster::SnapTriangle(vx, vy, [&](const int64_t* x, const int64_t* y) { RasteriseSnapped(p, x, y, vMin, vMax); });
+		}
+
+		// Attributes are planes over the whole primitive, so they are taken from its
+		// vertices whichever part of it, after guard band clipping, is drawn
+		void RasteriseSnapped(const Primitive& p, const int64_t* px, const int64_t* py, const olc::vi2d& vMin, const olc::vi2d& vMax)
+		{
+			const Vertex* v[3] = { &vVertices[p.v[0]], &vVertices[p.v[1]], &vVertices[p.v[2]] };
+			int64_t x[3] = { px[0], px[1], px[2] }, y[3] = { py[0], py[1], py[2] };
+
+			// Wind consistently so the inside is positive for all edges
+			const int64_t nArea = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+			if (nArea == 0) return;
+			if (nArea < 0) { std::swap(x[1], x[2]); std::swap(y[1], y[2]); std::swap(v[1], v[2]); }
+
+			raster::Edge e[3];
+			e[0].Setup(x[0], y[0], x[1], y[1]);
+			e[1].Setup(x[1], y[1], x[2], y[2]);
+			e[2].Setup(x[2], y[2], x[0], y[0]);
+
+			const int32_t nMinX = std::max(int32_t(raster::CeilDiv(std::min({ x[0], x[1], x[2] }))), vMin.x);
+			const int32_t nMaxX = std::min(int32_t(raster::FloorDiv(std::max({ x[0], x[1], x[2] }))), vMax.x);
+			const int32_t nMinY = std::max(int32_t(raster::CeilDiv(std::min({ y[0], y[1], y[2] }))), vMin.y);
+			const int32_t nMaxY = std::min(int32_t(raster::FloorDiv(std::max({ y[0], y[1], y[2] }))), vMax.y);
+			if (nMinX > nMaxX || nMinY > nMaxY) return;
+
+			// Every attribute is a plane over the screen, a(x, y) = a0 + dx * x + dy * y
+			const float fx1 = v[1]->x - v[0]->x, fy1 = v[1]->y - v[0]->y;
+			const float fx2 = v[2]->x - v[0]->x, fy2 = v[2]->y - v[0]->y;
+			const float fInvArea = 1.0f / (fx1 * fy2 - fx2 * fy1);
+			const float* a0 = v[0]->attrib; const float* a1 = v[1]->attrib; const float* a2 = v[2]->attrib;
+			float vDX[ATTRIBS], vDY[ATTRIBS];
+			for (int k = 0; k < ATTRIBS; k++)
+			{
+				vDX[k] = ((a1[k] - a0[k]) * fy2 - (a2[k] - a0[k]) * fy1) * fInvArea;
+				vDY[k] = ((a2[k] - a0[k]) * fx1 - (a1[k] - a0[k]) * fx2) * fInvArea;
+			}
+
+			const Texture* t = GetTexture(p.nTexture);
+			for (int32_t py = nMinY; py <= nMaxY; py++)
+			{
+				// Solve each edge for the run of pixels inside it on this row
+				int32_t nFirst = nMinX, nLast = nMaxX;
+				for (int k = 0; k < 3 && nFirst <= nLast; k++)
+				{
+					const int64_t c = e[k].C + e[k].B * py;
+					if (e[k].A > 0) nFirst = std::max(nFirst, -FloorDiv(c, e[k].A));
+					else if (e[k].A < 0) nLast = std::min(nLast, FloorDiv(c, -e[k].A));
+					else if (c < 0) nLast = nFirst - 1;
+				}
+
+				float f[ATTRIBS];
+				for (int k = 0; k < ATTRIBS; k++)
+					f[k] = a0[k] + vDX[k] * (float(nFirst) - v[0]->x) + vDY[k] * (float(py) - v[0]->y);
+
+				for (int32_t px = nFirst; px <= nLast; px++)
+				{
+					Shade(p, t, px, py, f);
+					for (int k = 0; k < ATTRIBS; k++) f[k] += vDX[k];
+				}
+			}
+		}
+
+		// Visits the pixel centres along the major axis from the first vertex up to,
+		// but not including, the last, so joined lines do not blend corners twice
+		void RasteriseLine(const Primitive& p, const olc::vi2d& vMin, const olc::vi2d& vMax)
+		{
+			const Vertex& v0 = vVertices[p.v[0]];
+			const Vertex& v1 = vVertices[p.v[1]];
+			const bool bMajorX = std::abs(v1.x - v0.x) >= std::abs(v1.y - v0.y);
+			const float fStart = bMajorX ? v0.x : v0.y, fEnd = bMajorX ? v1.x : v1.y;
+			const float fMinor = bMajorX ? v0.y : v0.x, fMinorEnd = bMajorX ? v1.y : v1.x;
+			if (fStart == fEnd) return;
+
+			const Texture* t = GetTexture(p.nTexture);
+			const int32_t nDir = fEnd > fStart ? 1 : -1;
+			for (int32_t i = int32_t(nDir > 0 ? std::ceil(fStart) : std::floor(fStart)); nDir > 0 ? float(i) < fEnd : float(i) > fEnd; i += nDir)
+			{
+				const float s = (float(i) - fStart) / (fEnd - fStart);
+				// Halfway cases round down in OpenGL's y up window coordinates
+				const float m = fMinor + (fMinorEnd - fMinor) * s;
+				const int32_t j = int32_t(bMajorX ? std::floor(m + 0.5f) : std::ceil(m - 0.5f));
+				const int32_t px = bMajorX ? i : j, py = bMajorX ? j : i;
+				if (px < vMin.x || px > vMax.x || py < vMin.y || py > vMax.y) continue;
+
+				float f[ATTRIBS];
+				for (int k = 0; k < ATTRIBS; k++) f[k] = v0.attrib[k] + (v1.attrib[k] - v0.attrib[k]) * s;
+				Shade(p, t, px, py, f);
+			}
 		}
 	};
 }
 #endif
 // O------------------------------------------------------------------------------O
-// | START IMAGE LOADER: stb_image.h                                              |
+// | END RENDERER: Software (no GPU? no problem...)                               |
 // O------------------------------------------------------------------------------O
 #pragma endregion
 
@@ -4750,6 +7778,8 @@ namespace olc
 		bool bSync = false;
 		olc::DecalMode nDecalMode = olc::DecalMode(-1); // Thanks Gusgo & Bispoo
 		olc::DecalStructure nDecalStructure = olc::DecalStructure(-1);
+		olc::vi2d vViewPos = { 0, 0 };
+		olc::vi2d vViewSize = { 0, 0 };
 #if defined(OLC_PLATFORM_X11)
 		X11::Display* olc_Display = nullptr;
 		X11::Window* olc_Window = nullptr;
@@ -4921,6 +7951,7 @@ namespace olc
 
 		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
 		{
+			stats.nDrawCalls++;
 			glBegin(GL_QUADS);
 			glColor4ub(tint.r, tint.g, tint.b, tint.a);
 			glTexCoord2f(0.0f * scale.x + offset.x, 1.0f * scale.y + offset.y);
@@ -4937,6 +7968,8 @@ namespace olc
 		void DrawDecal(const olc::DecalInstance& decal) override
 		{
 			SetDecalMode(decal.mode);
+			stats.nDrawCalls++;
+			stats.nTextureBinds++;
 
 			if (decal.decal == nullptr)
 				glBindTexture(GL_TEXTURE_2D, 0);
@@ -4991,6 +8024,9 @@ namespace olc
 		
 		}
 
+		void FlushDecals() override
+		{ }
+
 		uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered, const bool clamp) override
 		{
 			UNUSED(width);
@@ -5033,16 +8069,27 @@ namespace olc
 		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
 		{
 			UNUSED(id);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			stats.nBytesUploaded += uint64_t(spr->width) * uint64_t(spr->height) * sizeof(olc::Pixel);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data());
+		}
+
+		void UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			UNUSED(id);
+			stats.nBytesUploaded += uint64_t(size.x) * uint64_t(size.y) * sizeof(olc::Pixel);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, spr->width);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data() + pos.y * spr->width + pos.x);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 		}
 
 		void ReadTexture(uint32_t id, olc::Sprite* spr) override
 		{
-			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data());
 		}
 
 		void ApplyTexture(uint32_t id) override
 		{
+			stats.nTextureBinds++;
 			glBindTexture(GL_TEXTURE_2D, id);
 		}
 
@@ -5055,8 +8102,24 @@ namespace olc
 
 		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
 		{
+			vViewPos = pos;
+			vViewSize = size;
 			glViewport(pos.x, pos.y, size.x, size.y);
 		}
+
+		void SetDecalClip(const olc::vf2d& vMin, const olc::vf2d& vMax) override
+		{
+			if (vMin.x <= -1.0f && vMin.y <= -1.0f && vMax.x >= 1.0f && vMax.y >= 1.0f)
+			{
+				glDisable(GL_SCISSOR_TEST);
+				return;
+			}
+
+			const olc::vi2d vLo = vViewPos + olc::vi2d(((vMin + olc::vf2d(1.0f, 1.0f)) * 0.5f * olc::vf2d(vViewSize) + olc::vf2d(0.5f, 0.5f)).floor());
+			const olc::vi2d vHi = vViewPos + olc::vi2d(((vMax + olc::vf2d(1.0f, 1.0f)) * 0.5f * olc::vf2d(vViewSize) + olc::vf2d(0.5f, 0.5f)).floor());
+			glEnable(GL_SCISSOR_TEST);
+			glScissor(vLo.x, vLo.y, std::max(vHi.x - vLo.x, 0), std::max(vHi.y - vLo.y, 0));
+		}
 	};
 }
 #endif
@@ -5179,6 +8242,8 @@ namespace olc
 #endif
 		bool bSync = false;
 		olc::DecalMode nDecalMode = olc::DecalMode(-1); // Thanks Gusgo & Bispoo
+		olc::vi2d vViewPos = { 0, 0 };
+		olc::vi2d vViewSize = { 0, 0 };
 #if defined(OLC_PLATFORM_X11)
 		X11::Display* olc_Display = nullptr;
 		X11::Window* olc_Window = nullptr;
@@ -5196,6 +8261,7 @@ namespace olc
 		locAttachShader_t* locAttachShader = nullptr;
 		locBindBuffer_t* locBindBuffer = nullptr;
 		locBufferData_t* locBufferData = nullptr;
+		locBufferSubData_t* locBufferSubData = nullptr;
 		locGenBuffers_t* locGenBuffers = nullptr;
 		locVertexAttribPointer_t* locVertexAttribPointer = nullptr;
 		locEnableVertexAttribArray_t* locEnableVertexAttribArray = nullptr;
@@ -5204,13 +8270,29 @@ namespace olc
 		locGenVertexArrays_t* locGenVertexArrays = nullptr;
 		locSwapInterval_t* locSwapInterval = nullptr;
 		locGetShaderInfoLog_t* locGetShaderInfoLog = nullptr;
+		locVertexAttribDivisor_t* locVertexAttribDivisor = nullptr;
+		locDrawArraysInstanced_t* locDrawArraysInstanced = nullptr;
+		locMapBufferRange_t* locMapBufferRange = nullptr;
+		locUnmapBuffer_t* locUnmapBuffer = nullptr;
+		locFenceSync_t* locFenceSync = nullptr;
+		locClientWaitSync_t* locClientWaitSync = nullptr;
+		locDeleteSync_t* locDeleteSync = nullptr;
+		locTexStorage2D_t* locTexStorage2D = nullptr;
 
 		uint32_t m_nFS = 0;
 		uint32_t m_nVS = 0;
 		uint32_t m_nQuadShader = 0;
 		uint32_t m_vbQuad = 0;
+		uint32_t m_ibQuad = 0;
 		uint32_t m_vaQuad = 0;
 
+		// Instanced decals have their own vertex shader, which builds each quad
+		// from its DecalQuad and gl_VertexID, so only the instances are uploaded
+		uint32_t m_nInstanceVS = 0;
+		uint32_t m_nInstanceShader = 0;
+		uint32_t m_vbInstance = 0;
+		uint32_t m_vaInstance = 0;
+
 		struct locVertex
 		{
 			float pos[3];
@@ -5218,11 +8300,147 @@ namespace olc
 			olc::Pixel col;
 		};
 
-		locVertex pVertexMem[OLC_MAX_VERTS];
+		// Consecutive decals that share a texture and mode are gathered here as one
+		// indexed list, and drawn with a single call when either changes
+		std::vector<locVertex> vBatchVertices;
+		std::vector<uint32_t> vBatchIndices;
+		uint32_t nBatchTexture = 0;
+		olc::DecalMode nBatchMode = olc::DecalMode::NORMAL;
+
+		// Vertices and indices stream through ring buffers. When one is full its
+		// store is orphaned and writing restarts at the beginning, so an upload
+		// never overwrites data that a pending draw may still be reading
+		struct locRing
+		{
+			size_t nCapacity = 0;
+			size_t nCursor = 0;
+		};
+		locRing ringVertices;
+		locRing ringIndices;
+		locRing ringInstances;
+
+		// Points the instance attributes at the DecalQuads from nFirst onwards
+		void SetInstanceAttributes(size_t nFirst)
+		{
+			const size_t nBase = nFirst * sizeof(olc::DecalQuad);
+			locVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(olc::DecalQuad), (void*)(nBase + offsetof(olc::DecalQuad, origin)));
+			locVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(olc::DecalQuad), (void*)(nBase + offsetof(olc::DecalQuad, axisX)));
+			locVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(olc::DecalQuad), (void*)(nBase + offsetof(olc::DecalQuad, axisY)));
+			locVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(olc::DecalQuad), (void*)(nBase + offsetof(olc::DecalQuad, uvtl)));
+			locVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(olc::DecalQuad), (void*)(nBase + offsetof(olc::DecalQuad, tint)));
+		}
+
+		// Appends nCount elements to the ring for the buffer bound to target,
+		// returning the element offset they were written at
+		size_t RingWrite(locRing& ring, GLenum target, const void* pData, size_t nCount, size_t nStride)
+		{
+			if (ring.nCursor + nCount > ring.nCapacity)
+			{
+				while (ring.nCapacity < nCount) ring.nCapacity *= 2;
+				locBufferData(target, GLsizeiptr(ring.nCapacity * nStride), nullptr, 0x88E0);
+				ring.nCursor = 0;
+			}
+
+			locBufferSubData(target, GLintptr(ring.nCursor * nStride), GLsizeiptr(nCount * nStride), pData);
+			size_t nOffset = ring.nCursor;
+			ring.nCursor += nCount;
+			return nOffset;
+		}
+
+		// Textures get immutable storage when the driver has it, and uploads to them
+		// are copied into a pixel unpack buffer and sourced from there, so
+		// glTexSubImage2D() queues the transfer rather than copying the sprite
+		// before it returns. The two buffers alternate by frame, each fenced after
+		// its last upload, and are only written again once the GPU is done with them
+		struct locUploadBuffer
+		{
+			uint32_t id = 0;
+			size_t nCapacity = 0;
+			size_t nCursor = 0;
+			GLsync fence = nullptr;
+		};
+		std::array<locUploadBuffer, 2> vUploadBuffers;
+		size_t nUploadBuffer = 0;
+		bool bAsyncUploads = true;
+		bool bCanStream = false;
+		bool bCanTexStorage = false;
+		std::map<uint32_t, olc::vi2d> mapTexStorage;
+
+#if !defined(OLC_PLATFORM_EMSCRIPTEN)
+		// Sends a region of spr to the bound texture
+		void UploadRegion(olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size)
+		{
+			if (size.x <= 0 || size.y <= 0) return;
+			const olc::Pixel* pSource = spr->pColData.data() + pos.y * spr->width + pos.x;
+
+			if (bAsyncUploads && bCanStream)
+			{
+				locUploadBuffer& buf = vUploadBuffers[nUploadBuffer];
+				bool bOrphan = false;
+				if (buf.fence != nullptr)
+				{
+					// Unless GL_ALREADY_SIGNALED or GL_CONDITION_SATISFIED, the transfers may
+					// still be reading the store, so it is orphaned rather than overwritten
+					const GLenum nWait = locClientWaitSync(buf.fence, 0x00000001, 1000000000);
+					bOrphan = nWait != 0x911A && nWait != 0x911C;
+					locDeleteSync(buf.fence);
+					buf.fence = nullptr;
+				}
+
+				const size_t nRowBytes = size_t(size.x) * sizeof(olc::Pixel);
+				const size_t nBytes = nRowBytes * size_t(size.y);
+				locBindBuffer(0x88EC, buf.id);
+				if (bOrphan || buf.nCursor + nBytes > buf.nCapacity)
+				{
+					// Grow to hold everything uploaded so far this frame, orphaning
+					// the old store for the transfers still reading it
+					buf.nCapacity = std::max(buf.nCapacity, buf.nCursor + nBytes);
+					locBufferData(0x88EC, GLsizeiptr(buf.nCapacity), nullptr, 0x88E0);
+					buf.nCursor = 0;
+				}
+
+				uint8_t* pDest = (uint8_t*)locMapBufferRange(0x88EC, GLintptr(buf.nCursor), GLsizeiptr(nBytes), 0x0002 | 0x0004 | 0x0020);
+				if (pDest != nullptr)
+				{
+					if (size.x == spr->width)
+						std::memcpy(pDest, pSource, nBytes);
+					else
+						for (int32_t y = 0; y < size.y; y++)
+							std::memcpy(pDest + y * nRowBytes, pSource + y * spr->width, nRowBytes);
+					locUnmapBuffer(0x88EC);
+					glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, (void*)buf.nCursor);
+					buf.nCursor += nBytes;
+				}
+				locBindBuffer(0x88EC, 0);
+				if (pDest != nullptr) return;
+			}
+
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, spr->width);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, pSource);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		}
+
+		// Immutable storage cannot change size. A deleted name can be bound again
+		// in the compatibility contexts created here, giving a new texture, same id
+		void ReallocateStorage(uint32_t id, const olc::vi2d& vSize)
+		{
+			const GLenum nParams[4] = { GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER, GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T };
+			GLint nValues[4];
+			for (int i = 0; i < 4; i++) glGetTexParameteriv(GL_TEXTURE_2D, nParams[i], &nValues[i]);
+			glDeleteTextures(1, &id);
+			glBindTexture(GL_TEXTURE_2D, id);
+			for (int i = 0; i < 4; i++) glTexParameteri(GL_TEXTURE_2D, nParams[i], nValues[i]);
+			locTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, vSize.x, vSize.y);
+			mapTexStorage[id] = vSize;
+		}
+#endif
 
 		olc::Renderable rendBlankQuad;
 
 	public:
+		void SetAsyncUploads(bool bAsync) override
+		{ bAsyncUploads = bAsync; }
+
 		void PrepareDevice() override
 		{
 #if defined(OLC_PLATFORM_GLUT)
@@ -5340,6 +8558,7 @@ namespace olc
 			locAttachShader = OGL_LOAD(locAttachShader_t, glAttachShader);
 			locBindBuffer = OGL_LOAD(locBindBuffer_t, glBindBuffer);
 			locBufferData = OGL_LOAD(locBufferData_t, glBufferData);
+			locBufferSubData = OGL_LOAD(locBufferSubData_t, glBufferSubData);
 			locGenBuffers = OGL_LOAD(locGenBuffers_t, glGenBuffers);
 			locVertexAttribPointer = OGL_LOAD(locVertexAttribPointer_t, glVertexAttribPointer);
 			locEnableVertexAttribArray = OGL_LOAD(locEnableVertexAttribArray_t, glEnableVertexAttribArray);
@@ -5348,9 +8567,36 @@ namespace olc
 #if !defined(OLC_PLATFORM_EMSCRIPTEN)
 			locBindVertexArray = OGL_LOAD(locBindVertexArray_t, glBindVertexArray);
 			locGenVertexArrays = OGL_LOAD(locGenVertexArrays_t, glGenVertexArrays);
+			locVertexAttribDivisor = OGL_LOAD(locVertexAttribDivisor_t, glVertexAttribDivisor);
+			locDrawArraysInstanced = OGL_LOAD(locDrawArraysInstanced_t, glDrawArraysInstanced);
+			locMapBufferRange = OGL_LOAD(locMapBufferRange_t, glMapBufferRange);
+			locUnmapBuffer = OGL_LOAD(locUnmapBuffer_t, glUnmapBuffer);
+			locFenceSync = OGL_LOAD(locFenceSync_t, glFenceSync);
+			locClientWaitSync = OGL_LOAD(locClientWaitSync_t, glClientWaitSync);
+			locDeleteSync = OGL_LOAD(locDeleteSync_t, glDeleteSync);
+			locTexStorage2D = OGL_LOAD(locTexStorage2D_t, glTexStorage2D);
+
+			// Buffer mapping and fences are core in 3.3, texture storage only from 4.2
+			const char* sVersion = (const char*)glGetString(GL_VERSION);
+			const char* sExtensions = (const char*)glGetString(GL_EXTENSIONS);
+			const bool bVersion42 = sVersion != nullptr && (sVersion[0] > '4' || (sVersion[0] == '4' && sVersion[1] == '.' && sVersion[2] >= '2'));
+			bCanTexStorage = locTexStorage2D != nullptr
+				&& (bVersion42 || (sExtensions != nullptr && std::strstr(sExtensions, "GL_ARB_texture_storage") != nullptr));
+			bCanStream = locMapBufferRange != nullptr && locUnmapBuffer != nullptr
+				&& locFenceSync != nullptr && locClientWaitSync != nullptr && locDeleteSync != nullptr;
+			if (bCanStream)
+				for (auto& buf : vUploadBuffers)
+				{
+					buf = locUploadBuffer();
+					locGenBuffers(1, &buf.id);
+				}
+			nUploadBuffer = 0;
+			mapTexStorage.clear();
 #else
 			locBindVertexArray = glBindVertexArrayOES;
 			locGenVertexArrays = glGenVertexArraysOES;
+			locVertexAttribDivisor = glVertexAttribDivisorANGLE;
+			locDrawArraysInstanced = glDrawArraysInstancedANGLE;
 #endif
 
 			// Load & Compile Quad Shader - assumes no errors
@@ -5386,23 +8632,65 @@ namespace olc
 			locAttachShader(m_nQuadShader, m_nVS);
 			locLinkProgram(m_nQuadShader);
 
-			// Create Quad
+			m_nInstanceVS = locCreateShader(0x8B31);
+			const GLchar* strInstanceVS =
+#if defined(__arm__) || defined(OLC_PLATFORM_EMSCRIPTEN)
+				"#version 300 es\n"
+				"precision mediump float;"
+#else
+				"#version 330 core\n"
+#endif
+				"layout(location = 0) in vec2 aOrigin;\n""layout(location = 1) in vec2 aAxisX;\n""layout(location = 2) in vec2 aAxisY;\n"
+				"layout(location = 3) in vec4 aTex;\n""layout(location = 4) in vec4 aCol;\n""out vec2 oTex;\n""out vec4 oCol;\n"
+				"void main(){ vec2 c = vec2(float(gl_VertexID >> 1), float(gl_VertexID & 1));"
+				" gl_Position = vec4(aOrigin + c.x * aAxisX + c.y * aAxisY, 0.0, 1.0); oTex = mix(aTex.xy, aTex.zw, c); oCol = aCol;}";
+			locShaderSource(m_nInstanceVS, 1, &strInstanceVS, NULL);
+			locCompileShader(m_nInstanceVS);
+
+			m_nInstanceShader = locCreateProgram();
+			locAttachShader(m_nInstanceShader, m_nFS);
+			locAttachShader(m_nInstanceShader, m_nInstanceVS);
+			locLinkProgram(m_nInstanceShader);
+
+			// Create Quad, and the streaming buffers behind it
 			locGenBuffers(1, &m_vbQuad);
+			locGenBuffers(1, &m_ibQuad);
 			locGenVertexArrays(1, &m_vaQuad);
 			locBindVertexArray(m_vaQuad);
 			locBindBuffer(0x8892, m_vbQuad);
 
-			locVertex verts[OLC_MAX_VERTS];
-			locBufferData(0x8892, sizeof(locVertex) * OLC_MAX_VERTS, verts, 0x88E0);
+			ringVertices = { OLC_BATCH_VERTS, 0 };
+			locBufferData(0x8892, sizeof(locVertex) * ringVertices.nCapacity, nullptr, 0x88E0);
 			locVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(locVertex), 0); locEnableVertexAttribArray(0);
 			locVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(locVertex), (void*)(3 * sizeof(float))); locEnableVertexAttribArray(1);
 			locVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(locVertex), (void*)(5 * sizeof(float)));	locEnableVertexAttribArray(2);
-			locBindBuffer(0x8892, 0);
+
+			// Index buffer binding is part of the vertex array state
+			locBindBuffer(0x8893, m_ibQuad);
+			ringIndices = { OLC_BATCH_VERTS * 2, 0 };
+			locBufferData(0x8893, sizeof(uint32_t) * ringIndices.nCapacity, nullptr, 0x88E0);
+			locBindVertexArray(0);
+
+			// Instance attributes advance once per copy, not once per vertex
+			locGenBuffers(1, &m_vbInstance);
+			locGenVertexArrays(1, &m_vaInstance);
+			locBindVertexArray(m_vaInstance);
+			locBindBuffer(0x8892, m_vbInstance);
+			ringInstances = { OLC_BATCH_VERTS, 0 };
+			locBufferData(0x8892, sizeof(olc::DecalQuad) * ringInstances.nCapacity, nullptr, 0x88E0);
+			SetInstanceAttributes(0);
+			for (GLuint i = 0; i < 5; i++)
+			{
+				locEnableVertexAttribArray(i);
+				locVertexAttribDivisor(i, 1);
+			}
 			locBindVertexArray(0);
+			locBindBuffer(0x8892, 0);
+			locBindBuffer(0x8893, 0);
 
 			// Create blank texture for spriteless decals
 			rendBlankQuad.Create(1, 1);
-			rendBlankQuad.Sprite()->GetData()[0] = olc::WHITE;
+			rendBlankQuad.Sprite()->pColData.data()[0] = olc::WHITE;
 			rendBlankQuad.Decal()->Update();
 			return olc::rcode::OK;
 		}
@@ -5436,6 +8724,20 @@ namespace olc
 
 		void DisplayFrame() override
 		{
+			FlushDecals();
+
+			// Fence this frame's uploads and move on to the other buffer
+			if (bCanStream)
+			{
+				locUploadBuffer& buf = vUploadBuffers[nUploadBuffer];
+				if (buf.nCursor > 0)
+				{
+					buf.fence = locFenceSync(0x9117, 0);
+					buf.nCursor = 0;
+				}
+				nUploadBuffer = (nUploadBuffer + 1) % vUploadBuffers.size();
+			}
+
 #if defined(OLC_PLATFORM_WINAPI)
 			SwapBuffers(glDeviceContext);
 			if (bSync) DwmFlush(); // Woooohooooooo!!!! SMOOOOOOOTH!
@@ -5463,6 +8765,8 @@ namespace olc
 			locBindVertexArray(m_vaQuad);
 
 #if defined(OLC_PLATFORM_EMSCRIPTEN)
+			locBindBuffer(0x8892, m_vbQuad);
+			locBindBuffer(0x8893, m_ibQuad);
 			locVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(locVertex), 0); locEnableVertexAttribArray(0);
 			locVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(locVertex), (void*)(3 * sizeof(float))); locEnableVertexAttribArray(1);
 			locVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(locVertex), (void*)(5 * sizeof(float)));	locEnableVertexAttribArray(2);
@@ -5489,6 +8793,7 @@ namespace olc
 
 		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
 		{
+			FlushDecals();
 			locBindBuffer(0x8892, m_vbQuad);
 			locVertex verts[4] = {
 				{{-1.0f, -1.0f, 1.0}, {0.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
@@ -5497,36 +8802,97 @@ namespace olc
 				{{+1.0f, +1.0f, 1.0}, {1.0f * scale.x + offset.x, 0.0f * scale.y + offset.y}, tint},
 			};
 
-			locBufferData(0x8892, sizeof(locVertex) * 4, verts, 0x88E0);
-			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+			size_t nFirst = RingWrite(ringVertices, 0x8892, verts, 4, sizeof(locVertex));
+			stats.nDrawCalls++;
+			glDrawArrays(GL_TRIANGLE_STRIP, GLint(nFirst), 4);
 		}
 
 		void DrawDecal(const olc::DecalInstance& decal) override
 		{
-			SetDecalMode(decal.mode);
-			if (decal.decal == nullptr)
-				glBindTexture(GL_TEXTURE_2D, rendBlankQuad.Decal()->id);
-			else
-				glBindTexture(GL_TEXTURE_2D, decal.decal->id);
+			const uint32_t nTexture = decal.decal == nullptr ? rendBlankQuad.Decal()->id : decal.decal->id;
+			if (nTexture != nBatchTexture || decal.mode != nBatchMode
+				|| vBatchVertices.size() + decal.points > ringVertices.nCapacity
+				|| vBatchIndices.size() + size_t(decal.points) * 3 > ringIndices.nCapacity)
+				FlushDecals();
 
-			locBindBuffer(0x8892, m_vbQuad);
+			nBatchTexture = nTexture;
+			nBatchMode = decal.mode;
 
+			const uint32_t n = uint32_t(vBatchVertices.size());
 			for (uint32_t i = 0; i < decal.points; i++)
-				pVertexMem[i] = { { decal.pos[i].x, decal.pos[i].y, decal.w[i] }, { decal.uv[i].x, decal.uv[i].y }, decal.tint[i] };
+				vBatchVertices.push_back({ { decal.pos[i].x, decal.pos[i].y, decal.w[i] }, { decal.uv[i].x, decal.uv[i].y }, decal.tint[i] });
 
-			locBufferData(0x8892, sizeof(locVertex) * decal.points, pVertexMem, 0x88E0);
+			// Every structure is rewritten as an indexed list, so any decal can join the batch
+			if (decal.mode == DecalMode::WIREFRAME)
+			{
+				if (decal.points > 1)
+					for (uint32_t i = 0; i < decal.points; i++)
+						vBatchIndices.insert(vBatchIndices.end(), { n + i, n + (i + 1) % decal.points });
+			}
+			else if (decal.structure == olc::DecalStructure::FAN)
+			{
+				for (uint32_t i = 1; i + 1 < decal.points; i++)
+					vBatchIndices.insert(vBatchIndices.end(), { n, n + i, n + i + 1 });
+			}
+			else if (decal.structure == olc::DecalStructure::STRIP)
+			{
+				// Odd triangles of a strip swap their first two vertices to keep the winding
+				for (uint32_t i = 0; i + 2 < decal.points; i++)
+					if (i & 1)
+						vBatchIndices.insert(vBatchIndices.end(), { n + i + 1, n + i, n + i + 2 });
+					else
+						vBatchIndices.insert(vBatchIndices.end(), { n + i, n + i + 1, n + i + 2 });
+			}
+			else if (decal.structure == olc::DecalStructure::LIST)
+			{
+				for (uint32_t i = 0; i + 2 < decal.points; i += 3)
+					vBatchIndices.insert(vBatchIndices.end(), { n + i, n + i + 1, n + i + 2 });
+			}
+		}
 
-			if (nDecalMode == DecalMode::WIREFRAME)
-				glDrawArrays(GL_LINE_LOOP, 0, decal.points);
-			else
+		void FlushDecals() override
+		{
+			if (!vBatchIndices.empty())
 			{
-				if (decal.structure == olc::DecalStructure::FAN)
-					glDrawArrays(GL_TRIANGLE_FAN, 0, decal.points);
-				else if (decal.structure == olc::DecalStructure::STRIP)
-					glDrawArrays(GL_TRIANGLE_STRIP, 0, decal.points);
-				else if (decal.structure == olc::DecalStructure::LIST)
-					glDrawArrays(GL_TRIANGLES, 0, decal.points);
+				SetDecalMode(nBatchMode);
+				glBindTexture(GL_TEXTURE_2D, nBatchTexture);
+				stats.nTextureBinds++;
+				stats.nDrawCalls++;
+
+				locBindBuffer(0x8892, m_vbQuad);
+				const uint32_t nBase = uint32_t(RingWrite(ringVertices, 0x8892, vBatchVertices.data(), vBatchVertices.size(), sizeof(locVertex)));
+				if (nBase != 0)
+					for (auto& i : vBatchIndices) i += nBase;
+
+				locBindBuffer(0x8893, m_ibQuad);
+				const size_t nFirst = RingWrite(ringIndices, 0x8893, vBatchIndices.data(), vBatchIndices.size(), sizeof(uint32_t));
+				glDrawElements(nBatchMode == DecalMode::WIREFRAME ? GL_LINES : GL_TRIANGLES, GLsizei(vBatchIndices.size()), GL_UNSIGNED_INT, (void*)(nFirst * sizeof(uint32_t)));
 			}
+
+			vBatchVertices.clear();
+			vBatchIndices.clear();
+		}
+
+		void DrawDecalInstanced(const olc::DecalInstance& decal) override
+		{
+			// Outlines are line loops, which the batch already handles
+			if (decal.mode == DecalMode::WIREFRAME)
+				return Renderer::DrawDecalInstanced(decal);
+
+			FlushDecals();
+			SetDecalMode(decal.mode);
+			glBindTexture(GL_TEXTURE_2D, decal.decal == nullptr ? rendBlankQuad.Decal()->id : decal.decal->id);
+			stats.nTextureBinds++;
+			stats.nDrawCalls++;
+
+			locUseProgram(m_nInstanceShader);
+			locBindVertexArray(m_vaInstance);
+			locBindBuffer(0x8892, m_vbInstance);
+			SetInstanceAttributes(RingWrite(ringInstances, 0x8892, decal.instances, decal.instanceCount, sizeof(olc::DecalQuad)));
+			locDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, GLsizei(decal.instanceCount));
+
+			locUseProgram(m_nQuadShader);
+			locBindVertexArray(m_vaQuad);
 		}
 
 		uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered, const bool clamp) override
@@ -5560,34 +8926,68 @@ namespace olc
 			}
 #if !defined(OLC_PLATFORM_EMSCRIPTEN)
 			glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+			if (bCanTexStorage && width > 0 && height > 0)
+			{
+				locTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, GLsizei(width), GLsizei(height));
+				mapTexStorage[id] = { int32_t(width), int32_t(height) };
+			}
 #endif
 			return id;
 		}
 
 		uint32_t DeleteTexture(const uint32_t id) override
 		{
+			FlushDecals();
 			glDeleteTextures(1, &id);
+			mapTexStorage.erase(id);
 			return id;
 		}
 
 		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			stats.nBytesUploaded += uint64_t(spr->width) * uint64_t(spr->height) * sizeof(olc::Pixel);
+#if !defined(OLC_PLATFORM_EMSCRIPTEN)
+			auto it = mapTexStorage.find(id);
+			if (it != mapTexStorage.end() && spr->width > 0 && spr->height > 0)
+			{
+				if (it->second != spr->Size()) ReallocateStorage(id, spr->Size());
+				UploadRegion(spr, { 0, 0 }, spr->Size());
+				return;
+			}
+#endif
+			UNUSED(id);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data());
+		}
+
+		void UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) override
 		{
 			UNUSED(id);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+#if defined(OLC_PLATFORM_EMSCRIPTEN)
+			// GLES2 has no unpack row length, so send whole rows of the region
+			stats.nBytesUploaded += uint64_t(spr->width) * uint64_t(size.y) * sizeof(olc::Pixel);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, pos.y, spr->width, size.y, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data() + pos.y * spr->width);
+#else
+			stats.nBytesUploaded += uint64_t(size.x) * uint64_t(size.y) * sizeof(olc::Pixel);
+			UploadRegion(spr, pos, size);
+#endif
 		}
 
 		void ReadTexture(uint32_t id, olc::Sprite* spr) override
 		{
-			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data());
 		}
 
 		void ApplyTexture(uint32_t id) override
 		{
+			FlushDecals();
+			stats.nTextureBinds++;
 			glBindTexture(GL_TEXTURE_2D, id);
 		}
 
 		void ClearBuffer(olc::Pixel p, bool bDepth) override
 		{
+			FlushDecals();
 			glClearColor(float(p.r) / 255.0f, float(p.g) / 255.0f, float(p.b) / 255.0f, float(p.a) / 255.0f);
 			glClear(GL_COLOR_BUFFER_BIT);
 			if (bDepth) glClear(GL_DEPTH_BUFFER_BIT);
@@ -5595,8 +8995,27 @@ namespace olc
 
 		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
 		{
+			FlushDecals();
+			vViewPos = pos;
+			vViewSize = size;
 			glViewport(pos.x, pos.y, size.x, size.y);
 		}
+
+		void SetDecalClip(const olc::vf2d& vMin, const olc::vf2d& vMax) override
+		{
+			// The batch so far was built under the old clip
+			FlushDecals();
+			if (vMin.x <= -1.0f && vMin.y <= -1.0f && vMax.x >= 1.0f && vMax.y >= 1.0f)
+			{
+				glDisable(GL_SCISSOR_TEST);
+				return;
+			}
+
+			const olc::vi2d vLo = vViewPos + olc::vi2d(((vMin + olc::vf2d(1.0f, 1.0f)) * 0.5f * olc::vf2d(vViewSize) + olc::vf2d(0.5f, 0.5f)).floor());
+			const olc::vi2d vHi = vViewPos + olc::vi2d(((vMax + olc::vf2d(1.0f, 1.0f)) * 0.5f * olc::vf2d(vViewSize) + olc::vf2d(0.5f, 0.5f)).floor());
+			glEnable(GL_SCISSOR_TEST);
+			glScissor(vLo.x, vLo.y, std::max(vHi.x - vLo.x, 0), std::max(vHi.y - vLo.y, 0));
+		}
 	};
 }
 #endif
@@ -6197,16 +9616,25 @@ namespace olc
 		X11::XVisualInfo* olc_VisualInfo;
 		X11::Colormap                olc_ColourMap;
 		X11::XSetWindowAttributes    olc_SetWindowAttribs;
+		int                          olc_WakePipe[2] = { -1, -1 };
 
 	public:
 		virtual olc::rcode ApplicationStartUp() override
 		{
+			// Written to by WakeSystemEvent(), so WaitSystemEvent() can poll it
+			// alongside the X connection
+			if (pipe(olc_WakePipe) == 0)
+			{
+				fcntl(olc_WakePipe[0], F_SETFL, O_NONBLOCK);
+				fcntl(olc_WakePipe[1], F_SETFL, O_NONBLOCK);
+			}
 			return olc::rcode::OK;
 		}
 
 		virtual olc::rcode ApplicationCleanUp() override
 		{
 			XDestroyWindow(olc_Display, olc_Window);
+			for (int& fd : olc_WakePipe) { if (fd >= 0) close(fd); fd = -1; }
 			return olc::rcode::OK;
 		}
 
@@ -6435,6 +9863,39 @@ namespace olc
 			}
 			return olc::OK;
 		}
+
+		virtual olc::rcode WaitSystemEvent(const float fTimeout) override
+		{
+			using namespace X11;
+			// Xlib may already have read events off the connection, the frame
+			// that handles them answers any wake as well
+			if (XPending(olc_Display))
+			{
+				ClearSystemEventWake();
+				return olc::OK;
+			}
+
+			pollfd fds[2] = { { XConnectionNumber(olc_Display), POLLIN, 0 }, { olc_WakePipe[0], POLLIN, 0 } };
+			poll(fds, olc_WakePipe[0] >= 0 ? 2 : 1, fTimeout < 0.0f ? -1 : int(std::ceil(fTimeout * 1000.0f)));
+
+			// One wake is as good as many
+			if (fds[1].revents & POLLIN) ClearSystemEventWake();
+			return olc::OK;
+		}
+
+		virtual void ClearSystemEventWake() override
+		{
+			if (olc_WakePipe[0] < 0) return;
+			char buffer[64];
+			while (read(olc_WakePipe[0], buffer, sizeof(buffer)) > 0) {}
+		}
+
+		virtual void WakeSystemEvent() override
+		{
+			if (olc_WakePipe[1] < 0) return;
+			const char c = 0;
+			if (write(olc_WakePipe[1], &c, 1) < 0) {} // Full, so a wake is pending anyway
+		}
 	};
 }
 #endif
@@ -7256,6 +10717,10 @@ namespace olc
 		renderer = std::make_unique<olc::Renderer_Headless>();
 #endif
 
+#if defined(OLC_GFX_SOFTWARE)
+		renderer = std::make_unique<olc::Renderer_Software>();
+#endif
+
 #if defined(OLC_GFX_OPENGL10)
 		renderer = std::make_unique<olc::Renderer_OGL10>();
 #endif